@@ -32,6 +32,13 @@ struct VRDataPacketV2
 };
 #pragma pack(pop)
 
+// VRDataPacketV2::flags
+enum VRPacketFlags
+{
+    VR_FLAG_BASIC_DATA     = 1 << 0,  // HMD + right controller poses
+    VR_FLAG_MONOTONIC_TIME = 1 << 1   // timestamp is time.perf_counter(), not time.time()
+};
+
 // Simple flat structure for game usage
 struct VRDataPacketFlat
 {
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <cmath>
+#include "VRDataPacketV2.h"
+
+// Compact V3 wire format: HMD + both controllers + inputs in 58 bytes
+// (V2 needs 84 bytes for HMD + one controller).
+//
+// - Orientation: "smallest three" quaternion. The largest |component| is dropped
+//   (its index stored in 2 bits, its sign forced positive since q == -q), the other
+//   three lie in [-1/sqrt2, 1/sqrt2] and are stored as int16.
+//   Stored components round to within VR3_QUAT_COMPONENT_ERROR (~1.1e-5); the rebuilt
+//   largest one can be off by ~3e-5. Worst-case rotation error is about 0.004 degrees.
+// - Position: int16 millimetres, +/-32.767 m range. Max error: 0.5 mm.
+// - Inputs: analog values as 8-bit fixed point, digital buttons as a bitmask.
+// Python: '<HBBd' + 3 * '3h3h' + 'H4B4b' = 58 bytes
+#pragma pack(push, 1)
+struct VR3DevicePose
+{
+    short q[3];      // Smallest-three quaternion components, scaled by VR3_QUAT_SCALE
+    short p_mm[3];   // Position in millimetres (OpenVR space, x, y, z)
+};
+
+struct VRDataPacketV3
+{
+    unsigned short version;       // 3 (V2 packets start with uint32 2, so the low half tells them apart)
+    unsigned char deviceMask;     // VR3_DEVICE_* bits for the poses that are valid, plus VR3_FLAG_* bits
+    unsigned char quatLargest;    // 2 bits per device (hmd, left, right): index of the dropped component (w,x,y,z)
+    double timestamp;
+
+    VR3DevicePose hmd;
+    VR3DevicePose left;
+    VR3DevicePose right;
+
+    unsigned short buttons;       // VR3_BUTTON_* bits
+    unsigned char trigger[2];     // [0] left, [1] right, 0..255 -> 0..1
+    unsigned char grip[2];
+    signed char pad_x[2];         // -127..127 -> -1..1
+    signed char pad_y[2];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(VRDataPacketV3) == 58, "VRDataPacketV3 layout is shared with fnvr_pose_pipe.py");
+
+enum VR3DeviceBits
+{
+    VR3_DEVICE_HMD   = 1 << 0,
+    VR3_DEVICE_LEFT  = 1 << 1,
+    VR3_DEVICE_RIGHT = 1 << 2,
+
+    // Not devices: packet flags sharing the top of deviceMask
+    VR3_FLAG_MONOTONIC_TIME = 1 << 7  // timestamp is time.perf_counter(), not time.time()
+};
+
+enum VR3ButtonBits
+{
+    VR3_BUTTON_RIGHT_MENU   = 1 << 0,
+    VR3_BUTTON_RIGHT_SYSTEM = 1 << 1,
+    VR3_BUTTON_LEFT_MENU    = 1 << 2,
+    VR3_BUTTON_LEFT_SYSTEM  = 1 << 3,
+    VR3_BUTTON_A            = 1 << 4,
+    VR3_BUTTON_B            = 1 << 5,
+    VR3_BUTTON_X            = 1 << 6,
+    VR3_BUTTON_Y            = 1 << 7
+};
+
+static const float VR3_QUAT_SCALE = 32767.0f * 1.41421356f;          // int16 full range over +/-1/sqrt2
+static const float VR3_QUAT_COMPONENT_ERROR = 0.5f / VR3_QUAT_SCALE;  // Rounding bound per stored component
+static const float VR3_POSITION_ERROR_M = 0.0005f;
+
+// --- Scalar codecs ---
+
+inline short VR3QuantizeSigned(float value, float scale, float limit)
+{
+    float scaled = value * scale;
+    if (scaled > limit) scaled = limit;
+    if (scaled < -limit) scaled = -limit;
+    return (short)(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+inline unsigned char VR3QuantizeUnit(float value)
+{
+    if (value <= 0.0f) return 0;
+    if (value >= 1.0f) return 255;
+    return (unsigned char)(value * 255.0f + 0.5f);
+}
+
+// q = (w, x, y, z). Returns the index of the dropped (largest) component.
+inline unsigned int VR3EncodeQuat(const float q[4], short out[3])
+{
+    unsigned int largest = 0;
+    float largestAbs = fabsf(q[0]);
+    for (unsigned int i = 1; i < 4; i++) {
+        if (fabsf(q[i]) > largestAbs) {
+            largestAbs = fabsf(q[i]);
+            largest = i;
+        }
+    }
+
+    // Normalize and flip so the dropped component is positive
+    float sumSq = q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3];
+    float inv = sumSq > 0.0f ? 1.0f / sqrtf(sumSq) : 1.0f;
+    if (q[largest] < 0.0f) inv = -inv;
+
+    for (unsigned int i = 0, j = 0; i < 4; i++) {
+        if (i != largest) {
+            out[j++] = VR3QuantizeSigned(q[i] * inv, VR3_QUAT_SCALE, 32767.0f);
+        }
+    }
+    return largest;
+}
+
+inline void VR3DecodeQuat(const short in[3], unsigned int largest, float q[4])
+{
+    const float invScale = 1.0f / VR3_QUAT_SCALE;
+    float sumSq = 0.0f;
+    for (unsigned int i = 0, j = 0; i < 4; i++) {
+        if (i != largest) {
+            q[i] = in[j++] * invScale;
+            sumSq += q[i] * q[i];
+        }
+    }
+    q[largest] = sumSq < 1.0f ? sqrtf(1.0f - sumSq) : 0.0f;
+}
+
+inline void VR3EncodePose(const float q[4], const float p[3], VR3DevicePose& pose, unsigned char& quatLargest, unsigned int device)
+{
+    unsigned int largest = VR3EncodeQuat(q, pose.q);
+    quatLargest = (unsigned char)((quatLargest & ~(3u << (device * 2))) | (largest << (device * 2)));
+    for (int i = 0; i < 3; i++) {
+        pose.p_mm[i] = VR3QuantizeSigned(p[i], 1000.0f, 32767.0f);
+    }
+}
+
+inline void VR3DecodePose(const VR3DevicePose& pose, unsigned char quatLargest, unsigned int device, float q[4], float p[3])
+{
+    VR3DecodeQuat(pose.q, (quatLargest >> (device * 2)) & 3u, q);
+    for (int i = 0; i < 3; i++) {
+        p[i] = pose.p_mm[i] * 0.001f;
+    }
+}
+
+// --- Packet conversion ---
+
+inline void ConvertFlatToV3(const VRDataPacketFlat& flat, VRDataPacketV3& v3)
+{
+    v3.version = 3;
+    v3.deviceMask = VR3_DEVICE_HMD | VR3_DEVICE_LEFT | VR3_DEVICE_RIGHT;
+    if (flat.flags & VR_FLAG_MONOTONIC_TIME) v3.deviceMask |= VR3_FLAG_MONOTONIC_TIME;
+    v3.quatLargest = 0;
+    v3.timestamp = flat.timestamp;
+
+    const float hmdQ[4] = { flat.hmd_qw, flat.hmd_qx, flat.hmd_qy, flat.hmd_qz };
+    const float hmdP[3] = { flat.hmd_px, flat.hmd_py, flat.hmd_pz };
+    const float leftQ[4] = { flat.left_qw, flat.left_qx, flat.left_qy, flat.left_qz };
+    const float leftP[3] = { flat.left_px, flat.left_py, flat.left_pz };
+    const float rightQ[4] = { flat.right_qw, flat.right_qx, flat.right_qy, flat.right_qz };
+    const float rightP[3] = { flat.right_px, flat.right_py, flat.right_pz };
+    VR3EncodePose(hmdQ, hmdP, v3.hmd, v3.quatLargest, 0);
+    VR3EncodePose(leftQ, leftP, v3.left, v3.quatLargest, 1);
+    VR3EncodePose(rightQ, rightP, v3.right, v3.quatLargest, 2);
+
+    v3.buttons = 0;
+    if (flat.right_menu > 0.5f)   v3.buttons |= VR3_BUTTON_RIGHT_MENU;
+    if (flat.right_system > 0.5f) v3.buttons |= VR3_BUTTON_RIGHT_SYSTEM;
+    if (flat.left_menu > 0.5f)    v3.buttons |= VR3_BUTTON_LEFT_MENU;
+    if (flat.left_system > 0.5f)  v3.buttons |= VR3_BUTTON_LEFT_SYSTEM;
+    if (flat.a_button > 0.5f)     v3.buttons |= VR3_BUTTON_A;
+    if (flat.b_button > 0.5f)     v3.buttons |= VR3_BUTTON_B;
+    if (flat.x_button > 0.5f)     v3.buttons |= VR3_BUTTON_X;
+    if (flat.y_button > 0.5f)     v3.buttons |= VR3_BUTTON_Y;
+
+    v3.trigger[0] = VR3QuantizeUnit(flat.left_trigger);
+    v3.trigger[1] = VR3QuantizeUnit(flat.right_trigger);
+    v3.grip[0] = VR3QuantizeUnit(flat.left_grip);
+    v3.grip[1] = VR3QuantizeUnit(flat.right_grip);
+    v3.pad_x[0] = (signed char)VR3QuantizeSigned(flat.left_pad_x, 127.0f, 127.0f);
+    v3.pad_x[1] = (signed char)VR3QuantizeSigned(flat.right_pad_x, 127.0f, 127.0f);
+    v3.pad_y[0] = (signed char)VR3QuantizeSigned(flat.left_pad_y, 127.0f, 127.0f);
+    v3.pad_y[1] = (signed char)VR3QuantizeSigned(flat.right_pad_y, 127.0f, 127.0f);
+}
+
+// Devices missing from deviceMask decode to identity orientation at the origin
+inline void ConvertV3ToFlat(const VRDataPacketV3& v3, VRDataPacketFlat& flat)
+{
+    float q[4], p[3];
+
+    flat.version = v3.version;
+    flat.flags = VR_FLAG_BASIC_DATA | ((v3.deviceMask & VR3_FLAG_MONOTONIC_TIME) ? VR_FLAG_MONOTONIC_TIME : 0);
+    flat.timestamp = v3.timestamp;
+
+    VR3DecodePose(v3.hmd, v3.quatLargest, 0, q, p);
+    if (!(v3.deviceMask & VR3_DEVICE_HMD)) { q[0] = 1.0f; q[1] = q[2] = q[3] = 0.0f; p[0] = p[1] = p[2] = 0.0f; }
+    flat.hmd_qw = q[0]; flat.hmd_qx = q[1]; flat.hmd_qy = q[2]; flat.hmd_qz = q[3];
+    flat.hmd_px = p[0]; flat.hmd_py = p[1]; flat.hmd_pz = p[2];
+
+    VR3DecodePose(v3.left, v3.quatLargest, 1, q, p);
+    if (!(v3.deviceMask & VR3_DEVICE_LEFT)) { q[0] = 1.0f; q[1] = q[2] = q[3] = 0.0f; p[0] = p[1] = p[2] = 0.0f; }
+    flat.left_qw = q[0]; flat.left_qx = q[1]; flat.left_qy = q[2]; flat.left_qz = q[3];
+    flat.left_px = p[0]; flat.left_py = p[1]; flat.left_pz = p[2];
+
+    VR3DecodePose(v3.right, v3.quatLargest, 2, q, p);
+    if (!(v3.deviceMask & VR3_DEVICE_RIGHT)) { q[0] = 1.0f; q[1] = q[2] = q[3] = 0.0f; p[0] = p[1] = p[2] = 0.0f; }
+    flat.right_qw = q[0]; flat.right_qx = q[1]; flat.right_qy = q[2]; flat.right_qz = q[3];
+    flat.right_px = p[0]; flat.right_py = p[1]; flat.right_pz = p[2];
+
+    flat.left_trigger = v3.trigger[0] / 255.0f;
+    flat.right_trigger = v3.trigger[1] / 255.0f;
+    flat.left_grip = v3.grip[0] / 255.0f;
+    flat.right_grip = v3.grip[1] / 255.0f;
+    flat.left_pad_x = v3.pad_x[0] / 127.0f;
+    flat.right_pad_x = v3.pad_x[1] / 127.0f;
+    flat.left_pad_y = v3.pad_y[0] / 127.0f;
+    flat.right_pad_y = v3.pad_y[1] / 127.0f;
+
+    flat.right_menu   = (v3.buttons & VR3_BUTTON_RIGHT_MENU)   ? 1.0f : 0.0f;
+    flat.right_system = (v3.buttons & VR3_BUTTON_RIGHT_SYSTEM) ? 1.0f : 0.0f;
+    flat.left_menu    = (v3.buttons & VR3_BUTTON_LEFT_MENU)    ? 1.0f : 0.0f;
+    flat.left_system  = (v3.buttons & VR3_BUTTON_LEFT_SYSTEM)  ? 1.0f : 0.0f;
+    flat.a_button = (v3.buttons & VR3_BUTTON_A) ? 1.0f : 0.0f;
+    flat.b_button = (v3.buttons & VR3_BUTTON_B) ? 1.0f : 0.0f;
+    flat.x_button = (v3.buttons & VR3_BUTTON_X) ? 1.0f : 0.0f;
+    flat.y_button = (v3.buttons & VR3_BUTTON_Y) ? 1.0f : 0.0f;
+}
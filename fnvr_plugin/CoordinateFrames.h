@@ -0,0 +1,243 @@
+#pragma once
+
+#include "PoseMath.h"
+
+// Coordinate frames and the conversions between them, resolved at compile time.
+//
+// A Frame names where its +X, +Y and +Z point in the world (Basis), the handedness it
+// claims and its length unit. FrameConversion<From, To> folds two frames into one
+// signed axis permutation with a scale, plus the constant quaternion of the same
+// rotation, all constexpr: a position is three multiplies by constants, an orientation
+// a lane shuffle with sign flips. Nothing branches or renormalizes at run time.
+//
+// Checked at compile time: a frame's declared handedness matches its basis, a
+// conversion never mirrors (a mirror has no rotation quaternion), the quaternion is
+// the same rotation as the permutation, and the frames below round-trip exactly.
+//
+// C++11 constexpr (one return statement per function), so everything is spelled out
+// as expressions.
+
+namespace FNVR {
+
+// World directions an axis can point along
+enum Direction {
+    kDir_Right = 0, kDir_Left,
+    kDir_Up, kDir_Down,
+    kDir_Forward, kDir_Back
+};
+
+enum Handedness {
+    kRightHanded,
+    kLeftHanded
+};
+
+namespace FrameDetail {
+
+// Component (0 right, 1 up, 2 forward) and sign of a direction
+constexpr int AxisOf(Direction d) { return (int)d / 2; }
+constexpr float SignOf(Direction d) { return (int)d % 2 ? -1.0f : 1.0f; }
+
+constexpr float Abs(float v) { return v < 0.0f ? -v : v; }
+constexpr bool Near(float a, float b) { return Abs(a - b) < 1e-6f; }
+
+// sqrt(n) / 2 for n = 4 * (quaternion component)^2 of a signed permutation: 0, 1, 2 or 4
+constexpr float HalfRoot(float n)
+{
+    return n > 3.0f ? 1.0f : n > 1.5f ? 0.70710678118654752f : n > 0.5f ? 0.5f : 0.0f;
+}
+
+} // namespace FrameDetail
+
+template <Direction X, Direction Y, Direction Z>
+struct Basis {
+    static constexpr Direction Axis(int i) { return i == 0 ? X : i == 1 ? Y : Z; }
+
+    // Component j (right, up, forward) of axis i
+    static constexpr float Entry(int i, int j)
+    {
+        return FrameDetail::AxisOf(Axis(i)) == j ? FrameDetail::SignOf(Axis(i)) : 0.0f;
+    }
+
+    static constexpr float Determinant()
+    {
+        return Entry(0, 0) * (Entry(1, 1) * Entry(2, 2) - Entry(1, 2) * Entry(2, 1))
+             - Entry(0, 1) * (Entry(1, 0) * Entry(2, 2) - Entry(1, 2) * Entry(2, 0))
+             + Entry(0, 2) * (Entry(1, 0) * Entry(2, 1) - Entry(1, 1) * Entry(2, 0));
+    }
+};
+
+struct Meters {
+    static constexpr float PerMeter() { return 1.0f; }
+};
+
+struct GameUnits {
+    static constexpr float PerMeter() { return 70.0f; }  // Fallout NV: 70 units = 1 m
+};
+
+template <class BasisT, Handedness H, class UnitsT>
+struct Frame {
+    typedef BasisT BasisType;
+    typedef UnitsT UnitsType;
+    static constexpr Handedness kHandedness = H;
+
+    static_assert(BasisT::Determinant() != 0.0f, "Frame axes must point along three different world axes");
+    // (Right, Up, Forward) is itself left-handed: Right x Up points back, at the viewer
+    static_assert((BasisT::Determinant() > 0.0f) == (H == kLeftHanded), "Declared handedness does not match the basis");
+};
+
+template <class From, class To>
+struct FrameConversion {
+    static_assert(From::kHandedness == To::kHandedness,
+        "Frames of opposite handedness: the conversion would mirror, which no quaternion can express");
+
+    // Rotation matrix From -> To coordinates: To axis j . From axis i
+    static constexpr float M(int j, int i)
+    {
+        return To::BasisType::Entry(j, 0) * From::BasisType::Entry(i, 0)
+             + To::BasisType::Entry(j, 1) * From::BasisType::Entry(i, 1)
+             + To::BasisType::Entry(j, 2) * From::BasisType::Entry(i, 2);
+    }
+
+    // To component j = From component Source(j) * Factor(j)
+    static constexpr int Source(int j) { return M(j, 0) != 0.0f ? 0 : M(j, 1) != 0.0f ? 1 : 2; }
+    static constexpr float Sign(int j) { return M(j, Source(j)); }
+    static constexpr float Scale() { return To::UnitsType::PerMeter() / From::UnitsType::PerMeter(); }
+    static constexpr float Factor(int j) { return Sign(j) * Scale(); }
+
+    // Quaternion of the same rotation, component c = w, x, y, z. Matrix -> quaternion
+    // from the largest component, whose square root is exact for a signed permutation.
+    static constexpr float Q(int c)
+    {
+        return c == Largest() ? FrameDetail::HalfRoot(N(c))
+                              : Pair(Largest(), c) / (4.0f * FrameDetail::HalfRoot(N(Largest())));
+    }
+
+    static __m128 Rotation() { return MakeQuat(Q(0), Q(1), Q(2), Q(3)); }
+
+    // The quaternion rotates exactly like the permutation
+    static constexpr bool IsConsistent()
+    {
+        return EntryMatches(0, 0) && EntryMatches(0, 1) && EntryMatches(0, 2)
+            && EntryMatches(1, 0) && EntryMatches(1, 1) && EntryMatches(1, 2)
+            && EntryMatches(2, 0) && EntryMatches(2, 1) && EntryMatches(2, 2);
+    }
+
+    // Point or offset; scale multiplies the units' own (e.g. a configured units-per-meter).
+    // out may alias in.
+    static void Position(const float* in, float* out, float scale = 1.0f)
+    {
+        constexpr int s0 = Source(0), s1 = Source(1), s2 = Source(2);
+        constexpr float f0 = Factor(0), f1 = Factor(1), f2 = Factor(2);
+        const float x = in[s0] * f0, y = in[s1] * f1, z = in[s2] * f2;
+        out[0] = x * scale;
+        out[1] = y * scale;
+        out[2] = z * scale;
+    }
+
+    // The same mapping as matrix rows (translation 0), for baking into longer chains
+    static void Rows(float scale, MatrixRows& out)
+    {
+        out.row[0] = _mm_setr_ps(M(0, 0) * Scale() * scale, M(0, 1) * Scale() * scale, M(0, 2) * Scale() * scale, 0.0f);
+        out.row[1] = _mm_setr_ps(M(1, 0) * Scale() * scale, M(1, 1) * Scale() * scale, M(1, 2) * Scale() * scale, 0.0f);
+        out.row[2] = _mm_setr_ps(M(2, 0) * Scale() * scale, M(2, 1) * Scale() * scale, M(2, 2) * Scale() * scale, 0.0f);
+    }
+
+    // An orientation given in From, expressed in To (both the world and the object's own
+    // axes): c q c*, which for a signed permutation keeps w and moves the vector part
+    // like a direction. (w, x, y, z) order; out may alias in.
+    static void Orientation(const float* wxyz, float* out)
+    {
+        constexpr int s0 = Source(0), s1 = Source(1), s2 = Source(2);
+        constexpr float f0 = Sign(0), f1 = Sign(1), f2 = Sign(2);
+        const float x = wxyz[1 + s0] * f0, y = wxyz[1 + s1] * f1, z = wxyz[1 + s2] * f2;
+        out[0] = wxyz[0];
+        out[1] = x;
+        out[2] = y;
+        out[3] = z;
+    }
+
+private:
+    // 4 * component^2
+    static constexpr float N(int c)
+    {
+        return c == 0 ? 1.0f + M(0, 0) + M(1, 1) + M(2, 2)
+             : c == 1 ? 1.0f + M(0, 0) - M(1, 1) - M(2, 2)
+             : c == 2 ? 1.0f - M(0, 0) + M(1, 1) - M(2, 2)
+             :          1.0f - M(0, 0) - M(1, 1) + M(2, 2);
+    }
+
+    static constexpr int Largest()
+    {
+        return N(0) >= N(1) && N(0) >= N(2) && N(0) >= N(3) ? 0
+             : N(1) >= N(2) && N(1) >= N(3) ? 1
+             : N(2) >= N(3) ? 2 : 3;
+    }
+
+    // 4 * component a * component b, a != b
+    static constexpr float Pair(int a, int b)
+    {
+        return a > b ? Pair(b, a)
+             : a == 0 && b == 1 ? M(2, 1) - M(1, 2)
+             : a == 0 && b == 2 ? M(0, 2) - M(2, 0)
+             : a == 0 && b == 3 ? M(1, 0) - M(0, 1)
+             : a == 1 && b == 2 ? M(0, 1) + M(1, 0)
+             : a == 1 && b == 3 ? M(0, 2) + M(2, 0)
+             :                    M(1, 2) + M(2, 1);
+    }
+
+    // Entry (j, i) of Q's rotation matrix (column vectors, as QuatToRows)
+    static constexpr float QuatEntry(int j, int i)
+    {
+        return j == i ? 1.0f - 2.0f * (Q(1 + (j + 1) % 3) * Q(1 + (j + 1) % 3) + Q(1 + (j + 2) % 3) * Q(1 + (j + 2) % 3))
+             : (i - j + 3) % 3 == 1 ? 2.0f * (Q(1 + j) * Q(1 + i) - Q(0) * Q(1 + (j + 2) % 3))
+             :                        2.0f * (Q(1 + j) * Q(1 + i) + Q(0) * Q(1 + (j + 1) % 3));
+    }
+
+    static constexpr bool EntryMatches(int j, int i) { return FrameDetail::Near(QuatEntry(j, i), M(j, i)); }
+};
+
+// A there-and-back conversion is the identity: permutations undo each other, factors
+// multiply to one, and the two quaternions to +/-1
+template <class A, class B>
+constexpr bool RoundTripAxis(int i)
+{
+    return FrameConversion<A, B>::Source(FrameConversion<B, A>::Source(i)) == i
+        && FrameDetail::Near(FrameConversion<B, A>::Factor(i) * FrameConversion<A, B>::Factor(FrameConversion<B, A>::Source(i)), 1.0f);
+}
+
+template <class A, class B>
+constexpr bool RoundTripIsIdentity()
+{
+    return RoundTripAxis<A, B>(0) && RoundTripAxis<A, B>(1) && RoundTripAxis<A, B>(2)
+        && FrameDetail::Near(FrameDetail::Abs(
+               FrameConversion<B, A>::Q(0) * FrameConversion<A, B>::Q(0) - FrameConversion<B, A>::Q(1) * FrameConversion<A, B>::Q(1)
+             - FrameConversion<B, A>::Q(2) * FrameConversion<A, B>::Q(2) - FrameConversion<B, A>::Q(3) * FrameConversion<A, B>::Q(3)), 1.0f);
+}
+
+// --- The frames FNVR works in ---
+
+// Tracker space (OpenVR): +X right, +Y up, -Z forward, meters
+typedef Frame<Basis<kDir_Right, kDir_Up, kDir_Back>, kRightHanded, Meters> OpenVRFrame;
+
+// Gamebryo world and NiNode space: +X right, +Y forward, +Z up, game units
+typedef Frame<Basis<kDir_Right, kDir_Forward, kDir_Up>, kRightHanded, GameUnits> GamebryoFrame;
+
+// Gamebryo axes still in meters, for callers that scale by a configured units-per-meter
+typedef Frame<Basis<kDir_Right, kDir_Forward, kDir_Up>, kRightHanded, Meters> GamebryoAxesFrame;
+
+typedef FrameConversion<OpenVRFrame, GamebryoFrame> OpenVRToGamebryo;
+typedef FrameConversion<OpenVRFrame, GamebryoAxesFrame> OpenVRToGamebryoAxes;
+typedef FrameConversion<GamebryoAxesFrame, OpenVRFrame> GamebryoAxesToOpenVR;
+
+static_assert(OpenVRToGamebryo::IsConsistent(), "OpenVR -> Gamebryo quaternion disagrees with its axis permutation");
+static_assert(GamebryoAxesToOpenVR::IsConsistent(), "Gamebryo -> OpenVR quaternion disagrees with its axis permutation");
+static_assert(RoundTripIsIdentity<OpenVRFrame, GamebryoFrame>(), "OpenVR -> Gamebryo -> OpenVR is not the identity");
+static_assert(RoundTripIsIdentity<OpenVRFrame, GamebryoAxesFrame>(), "OpenVR -> Gamebryo axes -> OpenVR is not the identity");
+static_assert(RoundTripIsIdentity<GamebryoFrame, GamebryoAxesFrame>(), "Game units -> meters -> game units is not the identity");
+
+// Bone local rotations (apply path, VRManager): the tracked rotation pre-multiplied by
+// the Gamebryo -> OpenVR basis rotation, -90 degrees about X. This is the mapping the
+// bone path was tuned with in game; Orientation() is the full change of basis.
+inline __m128 OpenVRToGamebryoQuat() { return GamebryoAxesToOpenVR::Rotation(); }
+
+} // namespace FNVR
@@ -0,0 +1,61 @@
+// fnvr_plugin/DeviceCalibration.cpp
+#include "DeviceCalibration.h"
+#include <cmath>
+
+namespace FNVR {
+
+void DeviceCalibration::SetIdentity()
+{
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 4; j++) {
+            affine[i][j] = i == j ? 1.0f : 0.0f;
+        }
+    }
+    StoreQuat(rotationPre, MakeQuat(1.0f, 0.0f, 0.0f, 0.0f));
+    StoreQuat(rotationPost, MakeQuat(1.0f, 0.0f, 0.0f, 0.0f));
+}
+
+void DeviceCalibration::AppendTransform(const MatrixRows& rows)
+{
+    MatrixRows chain;
+    LoadRows34(&affine[0][0], chain);
+    ComposeRows(rows, chain, chain);
+    StoreRows34(&affine[0][0], chain);
+}
+
+void DeviceCalibration::AppendOffset(float x, float y, float z)
+{
+    affine[0][3] += x;
+    affine[1][3] += y;
+    affine[2][3] += z;
+}
+
+void DeviceCalibration::AppendRotation(__m128 pre, __m128 post)
+{
+    StoreQuat(rotationPre, QuatMultiply(pre, LoadQuat(rotationPre)));
+    StoreQuat(rotationPost, QuatMultiply(LoadQuat(rotationPost), post));
+}
+
+__m128 QuatFromAxisAngle(float x, float y, float z, float radians)
+{
+    float s = sinf(radians * 0.5f);
+    return MakeQuat(cosf(radians * 0.5f), x * s, y * s, z * s);
+}
+
+__m128 QuatFromEulerDegrees(float pitch, float yaw, float roll)
+{
+    const float halfDegToRad = 3.14159265359f / 360.0f;
+    float cy = cosf(yaw * halfDegToRad);
+    float sy = sinf(yaw * halfDegToRad);
+    float cp = cosf(pitch * halfDegToRad);
+    float sp = sinf(pitch * halfDegToRad);
+    float cr = cosf(roll * halfDegToRad);
+    float sr = sinf(roll * halfDegToRad);
+
+    return MakeQuat(cr * cp * cy + sr * sp * sy,
+                    sr * cp * cy - cr * sp * sy,
+                    cr * sp * cy + sr * cp * sy,
+                    cr * cp * sy - sr * sp * cy);
+}
+
+} // namespace FNVR
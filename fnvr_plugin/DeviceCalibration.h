@@ -0,0 +1,52 @@
+#pragma once
+
+#include "PoseMath.h"
+
+// One tracked device's calibration chain, baked into constants.
+//
+// Everything the config says about a device - frame change, scale, offsets, grip and
+// alignment rotations - is folded once, when the config changes, into a 3x4 affine for
+// positions and a quaternion pair for rotations. Applying it per frame is one
+// matrix-point transform and two quaternion products, with no trigonometry.
+//
+// Rotations take a pair (pre * q * post) because a frame change is a conjugation
+// (c q c*) and a grip correction acts in the device's own axes; a mirror of the
+// rotation (S R S) is a conjugation as well, by a 180 degree turn.
+//
+// Plain floats, not __m128 members: owners live on the x86 heap, which only
+// guarantees 8-byte alignment.
+
+namespace FNVR {
+
+struct DeviceCalibration {
+    float affine[3][4];     // Tracker position -> calibrated position; column 3: offset
+    float rotationPre[4];   // Tracker rotation q -> rotationPre * q * rotationPost, (w, x, y, z)
+    float rotationPost[4];
+
+    void SetIdentity();
+
+    // Chain builders; each step applies after everything baked so far
+    void AppendTransform(const MatrixRows& rows);                  // position: rows * chain
+    void AppendOffset(float x, float y, float z);                  // position: chain + offset
+    void AppendRotation(__m128 pre, __m128 post);                  // rotation: pre * chain * post
+
+    void TransformPosition(const float* in, float* out) const
+    {
+        MatrixRows rows;
+        LoadRows34(&affine[0][0], rows);
+        TransformPoint(rows, in, out);
+    }
+
+    __m128 TransformRotation(__m128 q) const
+    {
+        return QuatMultiply(QuatMultiply(LoadQuat(rotationPre), q), LoadQuat(rotationPost));
+    }
+};
+
+// Unit quaternion of a rotation by radians about the unit axis (x, y, z)
+__m128 QuatFromAxisAngle(float x, float y, float z, float radians);
+
+// Degrees, roll about X, pitch about Y, yaw about Z (VRConfig's angle convention)
+__m128 QuatFromEulerDegrees(float pitch, float yaw, float roll);
+
+} // namespace FNVR
@@ -0,0 +1,79 @@
+// fnvr_plugin/EulerBatch.cpp
+#include "EulerBatch.h"
+
+namespace FNVR {
+
+namespace {
+
+inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+} // namespace
+
+__m128 Atan2Degrees(__m128 y, __m128 x)
+{
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    __m128 ax = _mm_andnot_ps(signBit, x);
+    __m128 ay = _mm_andnot_ps(signBit, y);
+
+    // Reduce to atan(t), t = min / max in [0, 1]; both zero gives t = 0
+    __m128 hi = _mm_max_ps(ax, ay);
+    __m128 t = _mm_div_ps(_mm_min_ps(ax, ay), hi);
+    t = _mm_and_ps(t, _mm_cmpgt_ps(hi, _mm_setzero_ps()));
+
+    // atan(t) * 180/pi = t * P(t^2), Horner
+    __m128 u = _mm_mul_ps(t, t);
+    __m128 p = _mm_set1_ps(0.392053515f);
+    p = _mm_add_ps(_mm_mul_ps(p, u), _mm_set1_ps(-1.93235385f));
+    p = _mm_add_ps(_mm_mul_ps(p, u), _mm_set1_ps(4.57284498f));
+    p = _mm_add_ps(_mm_mul_ps(p, u), _mm_set1_ps(-7.59027147f));
+    p = _mm_add_ps(_mm_mul_ps(p, u), _mm_set1_ps(11.3521347f));
+    p = _mm_add_ps(_mm_mul_ps(p, u), _mm_set1_ps(-19.0899811f));
+    p = _mm_add_ps(_mm_mul_ps(p, u), _mm_set1_ps(57.2955856f));
+    __m128 angle = _mm_mul_ps(t, p);
+
+    // Back to the full circle: the steep octants, then the left half (x's sign bit, so
+    // -0 counts as left, as in libm), then y's sign
+    angle = Select(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(90.0f), angle), angle);
+    __m128 xNegative = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x), 31));
+    angle = Select(xNegative, _mm_sub_ps(_mm_set1_ps(180.0f), angle), angle);
+    return _mm_or_ps(angle, _mm_and_ps(y, signBit));
+}
+
+__m128 AsinDegrees(__m128 s)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    s = _mm_max_ps(_mm_min_ps(s, one), _mm_set1_ps(-1.0f));
+
+    // cos = sqrt((1 - s)(1 + s)): 1 - s is exact near |s| = 1, where 1 - s*s would cancel
+    __m128 cosine = _mm_sqrt_ps(_mm_mul_ps(_mm_sub_ps(one, s), _mm_add_ps(one, s)));
+    return Atan2Degrees(s, cosine);
+}
+
+void EulerBatch::Convert()
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    __m128 w = _mm_loadu_ps(qw);
+    __m128 x = _mm_loadu_ps(qx);
+    __m128 y = _mm_loadu_ps(qy);
+    __m128 z = _mm_loadu_ps(qz);
+
+    // Roll (x-axis rotation)
+    __m128 sinrCosp = _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(w, x), _mm_mul_ps(y, z)));
+    __m128 cosrCosp = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y))));
+    _mm_storeu_ps(roll, Atan2Degrees(sinrCosp, cosrCosp));
+
+    // Pitch (y-axis rotation), +/-90 when out of range
+    __m128 sinp = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(w, y), _mm_mul_ps(z, x)));
+    _mm_storeu_ps(pitch, AsinDegrees(sinp));
+
+    // Yaw (z-axis rotation)
+    __m128 sinyCosp = _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(w, z), _mm_mul_ps(x, y)));
+    __m128 cosyCosp = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(y, y), _mm_mul_ps(z, z))));
+    _mm_storeu_ps(yaw, Atan2Degrees(sinyCosp, cosyCosp));
+}
+
+} // namespace FNVR
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <emmintrin.h>
+
+// Quaternion -> Euler angles for several rotations at once, for the script globals.
+//
+// Same convention and outputs as TESGlobals::QuaternionToEuler (degrees; roll about
+// X, pitch about Y, yaw about Z; pitch clamped to +/-90), but four rotations per SSE
+// pass with polynomial atan2 instead of libm's atan2/asin.
+//
+// Error bounds (against libm in double on the same float inputs, measured by a sweep of
+// the circle, of [-1, 1] down to the last float below 1, and of 4M rotations on S3):
+//   Atan2Degrees   <= 3e-5 degrees everywhere (degree-13 odd polynomial on [0, 1],
+//                  least-squares fit at Chebyshev nodes, degree conversion folded in)
+//   AsinDegrees    <= 3e-5 degrees, also near +/-90: evaluated as
+//                  atan2(s, sqrt((1 - s)(1 + s))), which keeps 1 - s^2 exact there
+// Against the float QuaternionToEuler the angles stay within 1e-4 degrees - far below
+// anything a script can act on.
+
+namespace FNVR {
+
+// atan2(y, x) in degrees, (-180, 180]; signed zeros as libm
+__m128 Atan2Degrees(__m128 y, __m128 x);
+
+// asin(s) in degrees; |s| >= 1 gives +/-90
+__m128 AsinDegrees(__m128 s);
+
+// Four rotations in structure-of-arrays form (lane i = rotation i); unit quaternions
+struct EulerBatch {
+    float qw[4], qx[4], qy[4], qz[4];
+    float pitch[4], yaw[4], roll[4];  // Degrees, filled by Convert()
+
+    void Convert();
+};
+
+} // namespace FNVR
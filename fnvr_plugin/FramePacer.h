@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace FNVR {
+
+// Running estimate of the game's frame interval, fed once per frame from
+// kMessage_MainGameLoop. Readable from any thread.
+//
+// EWMA (1/8 per frame) with outlier rejection: a frame more than 2.5x or less
+// than 0.4x the estimate (load screens, alt-tab, a single hitch) is ignored, unless
+// kOutlierRunToAccept of them come in a row, in which case the rate really changed
+// (VorpX mode switch, vsync toggled) and the estimate restarts from there.
+class FramePacer
+{
+public:
+    FramePacer() { Reset(); }
+
+    static const uint32_t kDefaultIntervalUs = 16667;  // 60 fps until measured
+    static const uint32_t kMinIntervalUs = 4000;       // 250 fps
+    static const uint32_t kMaxIntervalUs = 50000;      // 20 fps
+    static const uint32_t kOutlierRunToAccept = 8;
+
+    // Main thread, once per frame; now in seconds from a monotonic clock
+    void Tick(double now)
+    {
+        double last = m_lastTick;
+        m_lastTick = now;
+        if (last <= 0.0) {
+            return;
+        }
+
+        double dt = now - last;
+        if (dt > m_interval * 2.5 || dt < m_interval * 0.4) {
+            m_rejected.fetch_add(1, std::memory_order_relaxed);
+            if (++m_outlierRun < kOutlierRunToAccept) {
+                return;
+            }
+            m_interval = dt;
+        } else {
+            m_interval += (dt - m_interval) * (1.0 / 8.0);
+        }
+        m_outlierRun = 0;
+
+        if (m_interval < kMinIntervalUs * 1e-6) m_interval = kMinIntervalUs * 1e-6;
+        if (m_interval > kMaxIntervalUs * 1e-6) m_interval = kMaxIntervalUs * 1e-6;
+        m_intervalUs.store((uint32_t)(m_interval * 1e6), std::memory_order_relaxed);
+    }
+
+    double GetFrameInterval() const { return m_intervalUs.load(std::memory_order_relaxed) * 1e-6; }
+    double GetFrameRate() const { return 1.0 / GetFrameInterval(); }
+    uint32_t GetRejectedCount() const { return m_rejected.load(std::memory_order_relaxed); }
+
+    // Main thread
+    void Reset()
+    {
+        m_interval = kDefaultIntervalUs * 1e-6;
+        m_intervalUs.store(kDefaultIntervalUs, std::memory_order_relaxed);
+        m_rejected.store(0, std::memory_order_relaxed);
+        m_lastTick = 0.0;
+        m_outlierRun = 0;
+    }
+
+private:
+    std::atomic<uint32_t> m_intervalUs;
+    std::atomic<uint32_t> m_rejected;
+
+    // Main thread only
+    double m_interval;
+    double m_lastTick;
+    uint32_t m_outlierRun;
+};
+
+} // namespace FNVR
@@ -0,0 +1,179 @@
+// fnvr_plugin/FrameProfiler.cpp
+#include "FrameProfiler.h"
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace FNVR {
+
+namespace {
+
+StageHistogram g_stages[kStage_Count];
+
+const char* const kStageNames[kStage_Count] = {
+    "IsGameStateValid",
+    "PlayerChecks",
+    "BuildBoneCache",
+    "BoneLookup",
+    "PoseSelect",
+    "PoseConversion",
+    "Head Update",
+    "Hand Update",
+    "Weapon Update",
+    "UpdateGlobals",
+    "BodyFix",
+    "LateLatch"
+};
+
+int HighestBit(uint64_t value)
+{
+    int bit = 0;
+    while (value >>= 1) {
+        bit++;
+    }
+    return bit;
+}
+
+#ifdef _WIN32
+uint64_t TicksPerSecond()
+{
+    static uint64_t frequency = 0;
+    if (frequency == 0) {
+        LARGE_INTEGER f;
+        QueryPerformanceFrequency(&f);
+        frequency = (uint64_t)f.QuadPart;
+    }
+    return frequency;
+}
+#endif
+
+} // namespace
+
+// --- StageHistogram ---
+
+StageHistogram::StageHistogram()
+{
+    Clear();
+    m_resetRequested.store(false, std::memory_order_relaxed);
+}
+
+void StageHistogram::Clear()
+{
+    for (int i = 0; i < kBucketCount; i++) {
+        m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_maxNs.store(0, std::memory_order_relaxed);
+}
+
+int StageHistogram::BucketForNs(uint64_t ns)
+{
+    if (ns < 16) {
+        return (int)ns;
+    }
+    int exponent = HighestBit(ns);
+    if (exponent >= 30) {
+        return kBucketCount - 1;  // Over ~1 s
+    }
+    int sub = (int)(ns >> (exponent - 3)) & 7;
+    return 16 + (exponent - 4) * 8 + sub;
+}
+
+uint64_t StageHistogram::BucketUpperNs(int bucket)
+{
+    if (bucket < 16) {
+        return bucket + 1;
+    }
+    int exponent = 4 + (bucket - 16) / 8;
+    int sub = (bucket - 16) % 8;
+    return (uint64_t)(9 + sub) << (exponent - 3);
+}
+
+void StageHistogram::Record(uint64_t ns)
+{
+    if (m_resetRequested.exchange(false, std::memory_order_relaxed)) {
+        Clear();
+    }
+
+    // Single writer: plain load/store pairs, as in LatencyHistogram
+    std::atomic<uint32_t>& bucket = m_buckets[BucketForNs(ns)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (ns > m_maxNs.load(std::memory_order_relaxed)) m_maxNs.store(ns, std::memory_order_relaxed);
+    m_count.store(m_count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+uint64_t StageHistogram::GetPercentileNs(double fraction) const
+{
+    uint32_t count = m_count.load(std::memory_order_acquire);
+    if (count == 0) {
+        return 0;
+    }
+
+    uint32_t target = (uint32_t)(fraction * count + 0.5);
+    if (target < 1) target = 1;
+    uint32_t seen = 0;
+    for (int i = 0; i < kBucketCount; i++) {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            uint64_t upper = i == kBucketCount - 1 ? GetMaxNs() : BucketUpperNs(i);
+            return upper < GetMaxNs() ? upper : GetMaxNs();
+        }
+    }
+    return GetMaxNs();
+}
+
+// --- FrameProfiler ---
+
+uint64_t FrameProfiler::ReadTicks()
+{
+#ifdef _WIN32
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)counter.QuadPart;
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+void FrameProfiler::Record(ProfileStage stage, uint64_t startTicks)
+{
+    uint64_t ticks = ReadTicks() - startTicks;
+#ifdef _WIN32
+    uint64_t ns = ticks * 1000000000ULL / TicksPerSecond();
+#else
+    uint64_t ns = ticks;
+#endif
+    g_stages[stage].Record(ns);
+}
+
+void FrameProfiler::RequestReset()
+{
+    for (int i = 0; i < kStage_Count; i++) {
+        g_stages[i].RequestReset();
+    }
+}
+
+const char* FrameProfiler::GetStageName(ProfileStage stage)
+{
+    return kStageNames[stage];
+}
+
+const StageHistogram& FrameProfiler::GetStage(ProfileStage stage)
+{
+    return g_stages[stage];
+}
+
+void FrameProfiler::FormatStage(ProfileStage stage, char* buffer, size_t size)
+{
+    const StageHistogram& h = g_stages[stage];
+    snprintf(buffer, size, "%-16s n=%u p50=%.1fus p99=%.1fus max=%.1fus", kStageNames[stage], h.GetCount(),
+        h.GetPercentileNs(0.50) * 1e-3, h.GetPercentileNs(0.99) * 1e-3, h.GetMaxNs() * 1e-3);
+}
+
+} // namespace FNVR
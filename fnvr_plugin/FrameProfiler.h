@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// Per-stage timing of the apply pipeline.
+//
+// Only compiled in with FNVR_ENABLE_PROFILER (CMake: -DFNVR_PROFILER=ON). Without it
+// FNVR_PROFILE_SCOPE expands to nothing, so release builds pay no cost at all.
+//
+//   void Foo() {
+//       FNVR_PROFILE_SCOPE(FNVR::kStage_PoseConversion);  // times the rest of the scope
+//       ...
+//   }
+
+namespace FNVR {
+
+enum ProfileStage {
+    kStage_GameState = 0,    // IsGameStateValid
+    kStage_PlayerChecks,     // Player validation and skeleton root
+    kStage_BoneCacheBuild,   // BuildBoneCache
+    kStage_BoneLookup,       // Bone cache lookup, per call
+    kStage_PoseSelect,       // Jitter buffer sample / packet poses
+    kStage_PoseConversion,   // Pose batch -> game space, per selection
+    kStage_HeadUpdate,       // NiNode::Update on the head
+    kStage_HandUpdate,       // NiNode::Update on the right hand
+    kStage_WeaponUpdate,     // NiNode::Update on the weapon node
+    kStage_UpdateGlobals,    // Globals::UpdateGlobals
+    kStage_BodyFix,          // FirstPersonBodyFix::Update
+    kStage_LateLatch,        // Whole late-latch pass
+    kStage_Count
+};
+
+// Lock-free duration histogram for one stage: one writer, any number of readers.
+// Log-linear buckets (8 per power of two, <= 12.5% error) from 16 ns to ~1 s.
+class StageHistogram
+{
+public:
+    StageHistogram();
+
+    void Record(uint64_t ns);
+
+    uint64_t GetPercentileNs(double fraction) const;
+    uint64_t GetMaxNs() const { return m_maxNs.load(std::memory_order_relaxed); }
+    uint32_t GetCount() const { return m_count.load(std::memory_order_relaxed); }
+
+    // Safe from any thread: the writer clears the counters before its next Record()
+    void RequestReset() { m_resetRequested.store(true, std::memory_order_relaxed); }
+
+    static const int kBucketCount = 16 + 26 * 8 + 1;
+
+private:
+    void Clear();
+    static int BucketForNs(uint64_t ns);
+    static uint64_t BucketUpperNs(int bucket);
+
+    std::atomic<uint32_t> m_buckets[kBucketCount];
+    std::atomic<uint32_t> m_count;
+    std::atomic<uint64_t> m_maxNs;
+    std::atomic<bool> m_resetRequested;
+};
+
+class FrameProfiler
+{
+public:
+    // Raw high-resolution counter (QueryPerformanceCounter / CLOCK_MONOTONIC ns)
+    static uint64_t ReadTicks();
+
+    static void Record(ProfileStage stage, uint64_t startTicks);
+    static void RequestReset();
+
+    static const char* GetStageName(ProfileStage stage);
+    static const StageHistogram& GetStage(ProfileStage stage);
+
+    // "BoneLookup          n=1234 p50=0.4us p99=1.9us max=12.0us" into buffer
+    static void FormatStage(ProfileStage stage, char* buffer, size_t size);
+};
+
+class ScopedStageTimer
+{
+public:
+    explicit ScopedStageTimer(ProfileStage stage) : m_stage(stage), m_start(FrameProfiler::ReadTicks()) {}
+    ~ScopedStageTimer() { FrameProfiler::Record(m_stage, m_start); }
+
+private:
+    ScopedStageTimer(const ScopedStageTimer&);
+    ScopedStageTimer& operator=(const ScopedStageTimer&);
+
+    ProfileStage m_stage;
+    uint64_t m_start;
+};
+
+} // namespace FNVR
+
+#ifdef FNVR_ENABLE_PROFILER
+#define FNVR_PROFILE_CONCAT_INNER(a, b) a##b
+#define FNVR_PROFILE_CONCAT(a, b) FNVR_PROFILE_CONCAT_INNER(a, b)
+#define FNVR_PROFILE_SCOPE(stage) FNVR::ScopedStageTimer FNVR_PROFILE_CONCAT(fnvrProfileScope, __LINE__)(stage)
+#else
+#define FNVR_PROFILE_SCOPE(stage) ((void)0)
+#endif
@@ -2,6 +2,8 @@
 #include "Globals.h"
 #include "VRSystem.h"
 #include "NVCSSkeleton.h"
+#include "CoordinateFrames.h"
+#include "EulerBatch.h"
 #include "nvse/GameData.h"
 #include <vector>
 #include <cmath>
@@ -87,10 +89,12 @@ namespace TESGlobals
     {
         // OpenVR: +Y up, +X right, -Z forward
         // Gamebryo: +Z up, +X right, +Y forward
-        // Transformation:
-        game_x = vr_x;
-        game_y = -vr_z;
-        game_z = vr_y;
+        const float vr[3] = {vr_x, vr_y, vr_z};
+        float game[3];
+        FNVR::OpenVRToGamebryoAxes::Position(vr, game);
+        game_x = game[0];
+        game_y = game[1];
+        game_z = game[2];
     }
 
     void InitGlobals()
@@ -208,7 +212,7 @@ namespace TESGlobals
     // Basic gesture detection thresholds
     static const float TRIGGER_THRESHOLD = 0.5f;  // For grip
 
-    void UpdateGlobals(const VRDataPacket& packet)
+    void UpdateGlobals(const VRPacketView& packet)
     {
         // NVCS Skeleton sistemini kullan
         FNVR::NVCSSkeleton::Manager& skeletonMgr = FNVR::NVCSSkeleton::Manager::GetSingleton();
@@ -223,22 +227,38 @@ namespace TESGlobals
         // Skeleton güncelle
         skeletonMgr.Update(packet);
         
+        HmdVector3_t headPos = skeletonMgr.GetBonePosition(FNVR::NVCSSkeleton::NVCS_BIP01_HEAD);
+        HmdQuaternionf_t headRot = skeletonMgr.GetBoneRotation(FNVR::NVCSSkeleton::NVCS_BIP01_HEAD);
+        // Right Hand değerleri (Weapon bone'dan daha iyi olabilir)
+        HmdVector3_t weaponPos = skeletonMgr.GetBonePosition(FNVR::NVCSSkeleton::NVCS_WEAPON);
+        HmdQuaternionf_t weaponRot = skeletonMgr.GetBoneRotation(FNVR::NVCSSkeleton::NVCS_WEAPON);
+        // Left Hand değerleri (şimdilik sağ el verisini mirror et)
+        HmdVector3_t leftHandPos = skeletonMgr.GetBonePosition(FNVR::NVCSSkeleton::NVCS_BIP01_L_HAND);
+        HmdQuaternionf_t leftHandRot = skeletonMgr.GetBoneRotation(FNVR::NVCSSkeleton::NVCS_BIP01_L_HAND);
+
+        // Quaternion'dan Euler açılarına dönüştür - üçü tek SSE geçişinde
+        // (lane 0: head, 1: right hand, 2: left hand, 3: identity)
+        const HmdQuaternionf_t* rotations[3] = { &headRot, &weaponRot, &leftHandRot };
+        FNVR::EulerBatch euler;
+        for (int i = 0; i < 3; i++) {
+            euler.qw[i] = rotations[i]->w;
+            euler.qx[i] = rotations[i]->x;
+            euler.qy[i] = rotations[i]->y;
+            euler.qz[i] = rotations[i]->z;
+        }
+        euler.qw[3] = 1.0f;
+        euler.qx[3] = euler.qy[3] = euler.qz[3] = 0.0f;
+        euler.Convert();
+
         // VorpX mode kontrolü - now using cached value
         if (!g_vorpxMode) {
             // Normal mod - HMD değerleri (Head bone'dan)
-            HmdVector3_t headPos = skeletonMgr.GetBonePosition(FNVR::NVCSSkeleton::NVCS_BIP01_HEAD);
-            HmdQuaternionf_t headRot = skeletonMgr.GetBoneRotation(FNVR::NVCSSkeleton::NVCS_BIP01_HEAD);
-            
-            // Quaternion'dan Euler açılarına dönüştür
-            float headPitch, headYaw, headRoll;
-            QuaternionToEuler(headRot.w, headRot.x, headRot.y, headRot.z, headPitch, headYaw, headRoll);
-            
             SAFE_SET_VALUE(FNVRHMDX, headPos.v[0]);
             SAFE_SET_VALUE(FNVRHMDY, headPos.v[1]);
             SAFE_SET_VALUE(FNVRHMDZ, headPos.v[2]);
-            SAFE_SET_VALUE(FNVRHMDPitch, headPitch);
-            SAFE_SET_VALUE(FNVRHMDYaw, headYaw);
-            SAFE_SET_VALUE(FNVRHMDRoll, headRoll);
+            SAFE_SET_VALUE(FNVRHMDPitch, euler.pitch[0]);
+            SAFE_SET_VALUE(FNVRHMDYaw, euler.yaw[0]);
+            SAFE_SET_VALUE(FNVRHMDRoll, euler.roll[0]);
         } else {
             // VorpX modunda HMD değerlerini sıfırla (VorpX kendi tracking'ini kullanıyor)
             SAFE_SET_VALUE(FNVRHMDX, 0.0f);
@@ -249,36 +269,22 @@ namespace TESGlobals
             SAFE_SET_VALUE(FNVRHMDRoll, 0.0f);
         }
         
-        // Right Hand değerleri (Weapon bone'dan daha iyi olabilir)
-        HmdVector3_t weaponPos = skeletonMgr.GetBonePosition(FNVR::NVCSSkeleton::NVCS_WEAPON);
-        HmdQuaternionf_t weaponRot = skeletonMgr.GetBoneRotation(FNVR::NVCSSkeleton::NVCS_WEAPON);
-        
-        float weaponPitch, weaponYaw, weaponRoll;
-        QuaternionToEuler(weaponRot.w, weaponRot.x, weaponRot.y, weaponRot.z, weaponPitch, weaponYaw, weaponRoll);
-        
         SAFE_SET_VALUE(FNVRRightX, weaponPos.v[0]);
         SAFE_SET_VALUE(FNVRRightY, weaponPos.v[1]);
         SAFE_SET_VALUE(FNVRRightZ, weaponPos.v[2]);
-        SAFE_SET_VALUE(FNVRRightPitch, weaponPitch);
-        SAFE_SET_VALUE(FNVRRightYaw, weaponYaw);
-        SAFE_SET_VALUE(FNVRRightRoll, weaponRoll);
-        
-        // Left Hand değerleri (şimdilik sağ el verisini mirror et)
-        HmdVector3_t leftHandPos = skeletonMgr.GetBonePosition(FNVR::NVCSSkeleton::NVCS_BIP01_L_HAND);
-        HmdQuaternionf_t leftHandRot = skeletonMgr.GetBoneRotation(FNVR::NVCSSkeleton::NVCS_BIP01_L_HAND);
-        
-        float leftPitch, leftYaw, leftRoll;
-        QuaternionToEuler(leftHandRot.w, leftHandRot.x, leftHandRot.y, leftHandRot.z, leftPitch, leftYaw, leftRoll);
+        SAFE_SET_VALUE(FNVRRightPitch, euler.pitch[1]);
+        SAFE_SET_VALUE(FNVRRightYaw, euler.yaw[1]);
+        SAFE_SET_VALUE(FNVRRightRoll, euler.roll[1]);
         
         SAFE_SET_VALUE(FNVRLeftX, leftHandPos.v[0]);
         SAFE_SET_VALUE(FNVRLeftY, leftHandPos.v[1]);
         SAFE_SET_VALUE(FNVRLeftZ, leftHandPos.v[2]);
-        SAFE_SET_VALUE(FNVRLeftPitch, leftPitch);
-        SAFE_SET_VALUE(FNVRLeftYaw, leftYaw);
-        SAFE_SET_VALUE(FNVRLeftRoll, leftRoll);
+        SAFE_SET_VALUE(FNVRLeftPitch, euler.pitch[2]);
+        SAFE_SET_VALUE(FNVRLeftYaw, euler.yaw[2]);
+        SAFE_SET_VALUE(FNVRLeftRoll, euler.roll[2]);
         
         // Basic right-hand gesture recognition (PoC)
-        if (packet.extended.right_trigger > TRIGGER_THRESHOLD) {
+        if (packet.GetTrigger(1) > TRIGGER_THRESHOLD) {
             // Grip gesture - Play animation using JohnnyGuitar
             // Placeholder: Assume PlayAnimation function from JohnnyGuitar
             // PlayAnimation(GetPlayer(), "GripAnim");  // Replace with actual call
@@ -3,7 +3,7 @@
 #include "nvse/GameForms.h"
 #include "nvse/GameAPI.h"   // For LookupFormByID, TESGlobal
 #include "nvse/GameData.h"  // For DataHandler
-#include "VRDataPacket.h"   // VRDataPacket tanımı
+#include "VRPacketView.h"   // VRPacketView / wire packet tanımları
 
 // Helper macro to simplify null checks. Can be used anywhere Globals.h is included.
 // JIP-LN SDK: TESGlobal type check için typeID kullanıyoruz
@@ -53,7 +53,7 @@ namespace TESGlobals
     // Status Global
     extern TESGlobal* FNVRStatus; // 0=Disconnected, 1=Connected, 2=Ver Mismatch
 
-    void UpdateGlobals(const VRDataPacket& packet);
+    void UpdateGlobals(const VRPacketView& packet);
     void InitGlobals();
     void ResetGlobals();
     
@@ -0,0 +1,185 @@
+// fnvr_plugin/LatencyStats.cpp
+#include "LatencyStats.h"
+#include <cstdio>
+#include <climits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace FNVR {
+
+// --- ClockSync ---
+
+ClockSync::ClockSync()
+{
+    Reset();
+}
+
+double ClockSync::WallNow()
+{
+#ifdef _WIN32
+    // 100 ns ticks since 1601-01-01; GetSystemTimePreciseAsFileTime is sub-microsecond
+    FILETIME ft;
+    GetSystemTimePreciseAsFileTime(&ft);
+    ULARGE_INTEGER ticks;
+    ticks.LowPart = ft.dwLowDateTime;
+    ticks.HighPart = ft.dwHighDateTime;
+    return (ticks.QuadPart - 116444736000000000ULL) * 1e-7;
+#else
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+double ClockSync::MonotonicNow()
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency = { 0 };
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+void ClockSync::Reset()
+{
+    m_floorUs.store(0, std::memory_order_relaxed);
+    m_windowMinUs[0] = LLONG_MAX;
+    m_windowMinUs[1] = LLONG_MAX;
+    m_windowSamples = 0;
+    m_lastMonotonic = false;
+}
+
+void ClockSync::AddSample(double trackerTimestamp, bool monotonic)
+{
+    if (monotonic != m_lastMonotonic) {
+        // Tracker switched clocks: the old envelope means nothing now
+        Reset();
+        m_lastMonotonic = monotonic;
+    }
+
+    int64_t deltaUs = (int64_t)((Now(monotonic) - trackerTimestamp) * 1e6);
+    if (deltaUs < m_windowMinUs[0]) {
+        m_windowMinUs[0] = deltaUs;
+    }
+
+    // Two staggered windows: the floor follows clock drift within 1-2 windows
+    if (++m_windowSamples >= kWindowSamples) {
+        m_windowMinUs[1] = m_windowMinUs[0];
+        m_windowMinUs[0] = LLONG_MAX;
+        m_windowSamples = 0;
+    }
+
+    int64_t floorUs = m_windowMinUs[0] < m_windowMinUs[1] ? m_windowMinUs[0] : m_windowMinUs[1];
+    m_floorUs.store(floorUs, std::memory_order_relaxed);
+}
+
+double ClockSync::GetLatency(double trackerTimestamp, double localTime) const
+{
+    double floor = GetTransportFloor();
+    double correction = floor < 0.0 ? floor : 0.0;
+    return (localTime - trackerTimestamp) - correction;
+}
+
+// --- LatencyHistogram ---
+
+LatencyHistogram::LatencyHistogram()
+{
+    Clear();
+    m_resetRequested.store(false, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::Clear()
+{
+    for (int i = 0; i < kBucketCount; i++) {
+        m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sumUs.store(0, std::memory_order_relaxed);
+    m_minUs.store(UINT_MAX, std::memory_order_relaxed);
+    m_maxUs.store(0, std::memory_order_relaxed);
+}
+
+int LatencyHistogram::BucketForMicroseconds(uint32_t us)
+{
+    if (us < 1000) return us / 25;                       // 0..39
+    if (us < 10000) return 40 + (us - 1000) / 100;       // 40..129
+    if (us < 100000) return 130 + (us - 10000) / 1000;   // 130..219
+    return kBucketCount - 1;                             // overflow
+}
+
+uint32_t LatencyHistogram::BucketUpperMicroseconds(int bucket)
+{
+    if (bucket < 40) return (bucket + 1) * 25;
+    if (bucket < 130) return 1000 + (bucket - 40 + 1) * 100;
+    if (bucket < 220) return 10000 + (bucket - 130 + 1) * 1000;
+    return UINT_MAX;
+}
+
+void LatencyHistogram::Record(double seconds)
+{
+    if (m_resetRequested.exchange(false, std::memory_order_relaxed)) {
+        Clear();
+    }
+
+    uint32_t us = seconds <= 0.0 ? 0 : seconds >= 4000.0 ? UINT_MAX - 1 : (uint32_t)(seconds * 1e6);
+
+    // Single writer: plain load/store pairs are enough, readers only need tear-free values
+    std::atomic<uint32_t>& bucket = m_buckets[BucketForMicroseconds(us)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    m_sumUs.store(m_sumUs.load(std::memory_order_relaxed) + us, std::memory_order_relaxed);
+    if (us < m_minUs.load(std::memory_order_relaxed)) m_minUs.store(us, std::memory_order_relaxed);
+    if (us > m_maxUs.load(std::memory_order_relaxed)) m_maxUs.store(us, std::memory_order_relaxed);
+    m_count.store(m_count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+double LatencyHistogram::GetPercentile(double fraction) const
+{
+    uint32_t count = m_count.load(std::memory_order_acquire);
+    if (count == 0) {
+        return 0.0;
+    }
+
+    uint32_t target = (uint32_t)(fraction * count + 0.5);
+    if (target < 1) target = 1;
+    uint32_t seen = 0;
+    for (int i = 0; i < kBucketCount; i++) {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return i == kBucketCount - 1 ? GetMax() : BucketUpperMicroseconds(i) * 1e-6;
+        }
+    }
+    return GetMax();
+}
+
+double LatencyHistogram::GetMin() const
+{
+    uint32_t us = m_minUs.load(std::memory_order_relaxed);
+    return us == UINT_MAX ? 0.0 : us * 1e-6;
+}
+
+double LatencyHistogram::GetMean() const
+{
+    uint32_t count = m_count.load(std::memory_order_acquire);
+    return count ? m_sumUs.load(std::memory_order_relaxed) * 1e-6 / count : 0.0;
+}
+
+void LatencyHistogram::FormatSummary(char* buffer, size_t size) const
+{
+    snprintf(buffer, size, "n=%u p50=%.2fms p95=%.2fms p99=%.2fms min=%.2fms mean=%.2fms max=%.2fms",
+        GetCount(), GetPercentile(0.50) * 1e3, GetPercentile(0.95) * 1e3, GetPercentile(0.99) * 1e3,
+        GetMin() * 1e3, GetMean() * 1e3, GetMax() * 1e3);
+}
+
+} // namespace FNVR
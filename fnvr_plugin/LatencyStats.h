@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace FNVR {
+
+// Maps tracker packet timestamps onto the plugin's clock.
+//
+// The tracker stamps packets with either time.time() (wall clock) or, with
+// --monotonic, time.perf_counter() (QueryPerformanceCounter on Windows,
+// CLOCK_MONOTONIC on Linux); the packet flags say which. Both are read on the same
+// host, so the true offset is ~0. What is estimated is the lower envelope of
+// (receive - timestamp) over a sliding window: the one-way transport floor. A
+// negative floor means the tracker's clock reads ahead of ours (time.time() ticks
+// coarsely on older Pythons, or the tracker runs elsewhere), and that amount is
+// taken off every latency so results stay causal.
+class ClockSync
+{
+public:
+    ClockSync();
+
+    static double WallNow();       // Unix seconds, same clock as time.time()
+    static double MonotonicNow();  // Seconds, same clock as time.perf_counter()
+    static double Now(bool monotonic) { return monotonic ? MonotonicNow() : WallNow(); }
+
+    // Pipe thread: call for every packet as it is received
+    void AddSample(double trackerTimestamp, bool monotonic);
+
+    // Any thread: age of a sample at localTime (same clock domain as the sample)
+    double GetLatency(double trackerTimestamp, double localTime) const;
+
+    // Windowed minimum of (receive - timestamp), in seconds
+    double GetTransportFloor() const { return m_floorUs.load(std::memory_order_relaxed) * 1e-6; }
+
+    void Reset();
+
+    static const uint32_t kWindowSamples = 512;  // ~4 s at 120 Hz
+
+private:
+    std::atomic<int64_t> m_floorUs;
+    int64_t m_windowMinUs[2];  // Current and previous window (pipe thread only)
+    uint32_t m_windowSamples;
+    bool m_lastMonotonic;
+};
+
+// Lock-free latency histogram: one writer (the apply stage), any number of readers.
+// Buckets: 25 us up to 1 ms, 100 us up to 10 ms, 1 ms up to 100 ms, then overflow.
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    void Record(double seconds);
+
+    // Value (seconds) below which `fraction` of the samples fall, to bucket resolution
+    double GetPercentile(double fraction) const;
+    uint32_t GetCount() const { return m_count.load(std::memory_order_relaxed); }
+    double GetMin() const;
+    double GetMax() const { return m_maxUs.load(std::memory_order_relaxed) * 1e-6; }
+    double GetMean() const;
+
+    // Safe from any thread: the writer clears the counters before its next Record()
+    void RequestReset() { m_resetRequested.store(true, std::memory_order_relaxed); }
+
+    // "n=1234 p50=8.2ms p95=11.4ms p99=15.0ms min=..." into buffer
+    void FormatSummary(char* buffer, size_t size) const;
+
+    static const int kBucketCount = 40 + 90 + 90 + 1;
+
+private:
+    void Clear();
+    static int BucketForMicroseconds(uint32_t us);
+    static uint32_t BucketUpperMicroseconds(int bucket);
+
+    std::atomic<uint32_t> m_buckets[kBucketCount];
+    std::atomic<uint32_t> m_count;
+    std::atomic<uint64_t> m_sumUs;
+    std::atomic<uint32_t> m_minUs;
+    std::atomic<uint32_t> m_maxUs;
+    std::atomic<bool> m_resetRequested;
+};
+
+} // namespace FNVR
@@ -1,5 +1,6 @@
 #include "internal/prefix.h"  // JIP-LN SDK prefix - temel tipler için
 #include "NVCSSkeleton.h"
+#include "CoordinateFrames.h"
 #include <cmath>
 
 // Basit log makrosu
@@ -63,85 +64,73 @@ const char* NVCSSkeleton::GetBoneName(NVCSBone bone) {
 }
 
 // VR to NVCS Mapping Implementation
-void NVCSSkeleton::VRToNVCSMapping::MapHMDToHead(const VRDataPacket& vrData, 
+void NVCSSkeleton::VRToNVCSMapping::MapHMDToHead(const VRPacketView& vrData, 
                                                   HmdVector3_t& headPos, 
                                                   HmdQuaternionf_t& headRot) {
     // OpenVR'dan gelen HMD verisini Gamebryo koordinatlarına dönüştür
-    // OpenVR: +Y up, -Z forward, +X right
-    // Gamebryo: +Z up, +Y forward, +X right
-    // Fallout NV: 70 units = 1 meter
-    
-    // Pozisyon dönüşümü - düzeltilmiş mapping
-    headPos.v[0] = vrData.hmd_px * 70.0f;   // X aynı kalır
-    headPos.v[1] = -vrData.hmd_pz * 70.0f;  // Y = -Z (OpenVR -Z forward'ı Gamebryo +Y forward'a)
-    headPos.v[2] = vrData.hmd_py * 70.0f;   // Z = Y (OpenVR up = Gamebryo up)
-    
-    // Quaternion dönüşümü - doğru rotasyon
-    // OpenVR quaternion'ı Gamebryo'ya dönüştür
-    headRot.w = vrData.hmd_qw;
-    headRot.x = vrData.hmd_qx;
-    headRot.y = vrData.hmd_qz;  // Y ve Z eksenleri yer değiştirir
-    headRot.z = vrData.hmd_qy;
+    // (CoordinateFrames.h: OpenVR -> Gamebryo, 70 units = 1 meter)
+    const VRPose& hmd = vrData.Hmd();
+    OpenVRToGamebryo::Position(&hmd.px, headPos.v);
+    OpenVRToGamebryo::Orientation(&hmd.qw, &headRot.w);
 }
 
-void NVCSSkeleton::VRToNVCSMapping::MapControllerToHand(const VRDataPacket& vrData, 
+void NVCSSkeleton::VRToNVCSMapping::RefreshHandCalibration() {
+    const HandSettings current = {g_vorpxMode, g_vorpxScaleFactor, g_rightHandOffsetX, g_rightHandOffsetY, g_rightHandOffsetZ};
+    if (current.vorpxMode == m_handSettings.vorpxMode && current.scale == m_handSettings.scale &&
+        current.offsetX == m_handSettings.offsetX && current.offsetY == m_handSettings.offsetY &&
+        current.offsetZ == m_handSettings.offsetZ) {
+        return;
+    }
+    m_handSettings = current;
+    
+    // OpenVR -> Gamebryo (70 units = 1 meter), VorpX scale uygula
+    MatrixRows toGame;
+    OpenVRToGamebryo::Rows(current.scale, toGame);
+    __m128 basis = OpenVRToGamebryo::Rotation();
+    
+    // Sağ el: controller grip rotasyonu düzeltmesi (silah doğru tutulsun), Vive/Index
+    // controller'lar için tipik -45 derece pitch (X ekseni etrafında), controller'ın kendi
+    // eksenlerinde
+    DeviceCalibration& right = m_handCalibration[1];
+    right.SetIdentity();
+    right.AppendTransform(toGame);
+    right.AppendOffset(current.offsetX, current.offsetY, current.offsetZ);
+    right.AppendRotation(basis, QuatConjugate(basis));
+    right.AppendRotation(MakeQuat(1.0f, 0.0f, 0.0f, 0.0f), QuatFromAxisAngle(1.0f, 0.0f, 0.0f, -45.0f * 3.14159f / 180.0f));
+    if (current.vorpxMode) {
+        // VorpX alignment: small yaw offset (5 degrees)
+        right.AppendRotation(QuatFromAxisAngle(0.0f, 1.0f, 0.0f, 5.0f * 3.14159f / 180.0f), MakeQuat(1.0f, 0.0f, 0.0f, 0.0f));
+    }
+    
+    // V2 paketlerinde sol el sağ controller'ın aynası: X ters, rotasyon YZ düzleminde ayna
+    // (180 derece X dönüşü ile conjugation: x aynı, y ve z ters); grip düzeltmesi yok
+    MatrixRows mirrorX;
+    mirrorX.row[0] = _mm_setr_ps(-1.0f, 0.0f, 0.0f, 0.0f);
+    mirrorX.row[1] = _mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f);
+    mirrorX.row[2] = _mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f);
+    __m128 turnX = MakeQuat(0.0f, 1.0f, 0.0f, 0.0f);
+    DeviceCalibration& left = m_handCalibration[0];
+    left.SetIdentity();
+    left.AppendTransform(toGame);
+    left.AppendTransform(mirrorX);
+    left.AppendOffset(current.offsetX, current.offsetY, current.offsetZ);  // Assuming same for left in PoC
+    left.AppendRotation(basis, QuatConjugate(basis));
+    left.AppendRotation(turnX, QuatConjugate(turnX));
+}
+
+void NVCSSkeleton::VRToNVCSMapping::MapControllerToHand(const VRPacketView& vrData, 
                                                          bool isRight,
                                                          HmdVector3_t& handPos, 
                                                          HmdQuaternionf_t& handRot) {
-    if (isRight) {
-        // Sağ controller pozisyonu - düzeltilmiş koordinat sistemi
-        handPos.v[0] = vrData.right_px * 70.0f * g_vorpxScaleFactor;   // X aynı, VorpX scale uygula
-        handPos.v[1] = vrData.right_pz * 70.0f * g_vorpxScaleFactor;   
-        handPos.v[2] = vrData.right_py * 70.0f * g_vorpxScaleFactor;   
-        
-        // Sağ controller rotasyonu - düzeltilmiş
-        handRot.w = vrData.right_qw;
-        handRot.x = vrData.right_qx;
-        handRot.y = vrData.right_qz;  // Y ve Z yer değiştirir
-        handRot.z = vrData.right_qy;
-        
-        // Controller grip rotasyonu düzeltmesi (silah doğru tutulsun)
-        // Vive/Index controller'lar için tipik düzeltme
-        float gripAngle = -45.0f * 3.14159f / 180.0f; // -45 derece pitch
-        float cosHalf = cos(gripAngle / 2);
-        float sinHalf = sin(gripAngle / 2);
-        
-        // Pitch rotasyonu ekle (X ekseni etrafında)
-        HmdQuaternionf_t gripRot = {cosHalf, sinHalf, 0, 0};
-        
-        // Quaternion çarpımı ile birleştir
-        HmdQuaternionf_t result;
-        result.w = handRot.w * gripRot.w - handRot.x * gripRot.x - handRot.y * gripRot.y - handRot.z * gripRot.z;
-        result.x = handRot.w * gripRot.x + handRot.x * gripRot.w + handRot.y * gripRot.z - handRot.z * gripRot.y;
-        result.y = handRot.w * gripRot.y - handRot.x * gripRot.z + handRot.y * gripRot.w + handRot.z * gripRot.x;
-        result.z = handRot.w * gripRot.z + handRot.x * gripRot.y - handRot.y * gripRot.x + handRot.z * gripRot.w;
-        
-        handRot = result;
-        
-        // VorpX-specific adjustment (e.g., additional rotation offset if needed)
-        if (g_vorpxMode) {
-            // Example: Add small yaw offset for VorpX alignment
-            float vorpxYawOffset = 5.0f * 3.14159f / 180.0f;  // 5 degrees
-            HmdQuaternionf_t yawRot = {cos(vorpxYawOffset / 2), 0, sin(vorpxYawOffset / 2), 0};
-            handRot = quaternion_multiply(yawRot, handRot);  // Assume quaternion_multiply function exists
-        }
-    } else {
-        // Sol controller desteği - mirror sağ controller
-        handPos.v[0] = -vrData.right_px * 70.0f * g_vorpxScaleFactor;  // X'i ters çevir (sol tarafa)
-        handPos.v[1] = vrData.right_pz * 70.0f * g_vorpxScaleFactor;   
-        handPos.v[2] = vrData.right_py * 70.0f * g_vorpxScaleFactor;
-        
-        // Sol el için rotasyon (şimdilik basit mirror)
-        handRot.w = vrData.right_qw;
-        handRot.x = -vrData.right_qx;  // X rotasyonunu ters çevir
-        handRot.y = vrData.right_qz;
-        handRot.z = vrData.right_qy;
-    }
-    
-    // Apply INI offsets (exclusive use)
-    handPos.v[0] += g_rightHandOffsetX;  // Assuming same for left in PoC
-    handPos.v[1] += g_rightHandOffsetY;
-    handPos.v[2] += g_rightHandOffsetZ;
+    RefreshHandCalibration();
+    
+    // V3 paketleri sol controller'ı da taşır: controller olduğu gibi, sağ elin zinciriyle.
+    // V2'de (sol controller yok) sol el sağ controller'ın aynası
+    const bool trackedLeft = !isRight && vrData.HasDevice(VR3_DEVICE_LEFT);
+    const VRPose& controller = trackedLeft ? vrData.Left() : vrData.Right();
+    const DeviceCalibration& calibration = m_handCalibration[(isRight || trackedLeft) ? 1 : 0];
+    calibration.TransformPosition(&controller.px, handPos.v);
+    StoreQuat(&handRot.w, calibration.TransformRotation(LoadQuat(&controller.qw)));
 }
 
 // Improved IK with pole vector
@@ -219,7 +208,7 @@ void NVCSSkeleton::Manager::Initialize() {
     m_playerHeight = GetPrivateProfileIntA("NVCS", "PlayerHeight", 175, iniPath);
 }
 
-void NVCSSkeleton::Manager::Update(const VRDataPacket& vrData) {
+void NVCSSkeleton::Manager::Update(const VRPacketView& vrData) {
     // VorpX mode kontrolü
     if (g_vorpxMode) {
         UpdateVorpXMode(vrData);
@@ -297,7 +286,7 @@ void NVCSSkeleton::Manager::UpdateWeaponPosition(const HmdVector3_t& handPos,
     m_boneRotations[NVCS_WEAPON] = handRot;
 }
 
-void NVCSSkeleton::Manager::UpdateVorpXMode(const VRDataPacket& vrData) {
+void NVCSSkeleton::Manager::UpdateVorpXMode(const VRPacketView& vrData) {
     // VorpX modunda sadece controller pozisyonlarını güncelle
     // Head tracking VorpX tarafından yapılıyor
     
@@ -331,12 +320,12 @@ void NVCSSkeleton::Manager::UpdateVorpXMode(const VRDataPacket& vrData) {
     m_boneRotations[NVCS_BIP01_L_HAND] = leftHandRot;
 }
 
-void NVCSSkeleton::Manager::Calibrate(const VRDataPacket& vrData) {
+void NVCSSkeleton::Manager::Calibrate(const VRPacketView& vrData) {
     // T-pose kalibrasyonu
     _MESSAGE("FNVR | Calibrating NVCS skeleton...");
     
     // Oyuncu boyunu HMD yüksekliğinden hesapla
-    m_playerHeight = vrData.hmd_py * 70.0f;
+    m_playerHeight = vrData.Hmd().py * 70.0f;
     
     // Omuz genişliğini tahmin et (boy oranına göre)
     m_shoulderWidth = m_playerHeight * 0.25f;
@@ -70,16 +70,31 @@ public:
     // VR Controller'dan NVCS bone'larına mapping
     struct VRToNVCSMapping {
         // HMD -> Head/Camera mapping
-        void MapHMDToHead(const VRDataPacket& vrData, HmdVector3_t& headPos, HmdQuaternionf_t& headRot);
+        void MapHMDToHead(const VRPacketView& vrData, HmdVector3_t& headPos, HmdQuaternionf_t& headRot);
         
-        // Right Controller -> Right Hand/Weapon mapping
-        void MapControllerToHand(const VRDataPacket& vrData, bool isRight, 
+        // Controller -> Hand/Weapon mapping (left: tracked controller if present, else mirrored right)
+        void MapControllerToHand(const VRPacketView& vrData, bool isRight, 
                                 HmdVector3_t& handPos, HmdQuaternionf_t& handRot);
         
         // IK hesaplamaları
         void CalculateArmIK(const HmdVector3_t& shoulderPos, const HmdVector3_t& handPos,
                            float upperArmLength, float foreArmLength,
                            HmdQuaternionf_t& upperArmRot, HmdQuaternionf_t& foreArmRot);
+        
+    private:
+        // Hand chains (scale, mirror, offsets, grip and VorpX rotations), rebuilt when
+        // the settings they were baked from change
+        struct HandSettings {
+            int vorpxMode;
+            float scale;
+            float offsetX, offsetY, offsetZ;
+        };
+        void RefreshHandCalibration();
+        
+        // [0] left hand mirrored from the right controller (V2), [1] a controller as held
+        // (the right hand, and the left when the packet tracks it)
+        DeviceCalibration m_handCalibration[2];
+        HandSettings m_handSettings = {-1, 0.0f, 0.0f, 0.0f, 0.0f};
     };
 
     // NVCS skeleton yönetimi
@@ -104,9 +119,9 @@ public:
         static Manager& GetSingleton();
         
         void Initialize();
-        void Update(const VRDataPacket& vrData);
-        void UpdateVorpXMode(const VRDataPacket& vrData);
-        void Calibrate(const VRDataPacket& vrData);
+        void Update(const VRPacketView& vrData);
+        void UpdateVorpXMode(const VRPacketView& vrData);
+        void Calibrate(const VRPacketView& vrData);
         
         // Bone getter/setter
         HmdVector3_t GetBonePosition(NVCSBone bone) const;
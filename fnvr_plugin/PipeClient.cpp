@@ -9,11 +9,19 @@
 #endif
 
 PipeClient::PipeClient(const std::string& pipeName)
-    : m_pipeName(pipeName), m_pipeHandle(INVALID_HANDLE_VALUE), m_isConnected(false) {}
+    : m_pipeName(pipeName), m_pipeHandle(INVALID_HANDLE_VALUE), m_readEvent(NULL), m_cancelEvent(NULL),
+      m_isConnected(false), m_drainMode(false), m_droppedPackets(0), m_packetSize(0)
+{
+    ZeroMemory(&m_overlapped, sizeof(m_overlapped));
+    m_readEvent = CreateEventA(NULL, TRUE, FALSE, NULL);
+}
 
 PipeClient::~PipeClient()
 {
     Disconnect();
+    if (m_readEvent) {
+        CloseHandle(m_readEvent);
+    }
 }
 
 bool PipeClient::Connect()
@@ -28,13 +36,14 @@ bool PipeClient::Connect()
         0,
         NULL,
         OPEN_EXISTING,
-        0,
+        FILE_FLAG_OVERLAPPED,
         NULL);
 
     if (m_pipeHandle != INVALID_HANDLE_VALUE)
     {
         _MESSAGE("FNVR | Connected to named pipe: %s", m_pipeName.c_str());
         m_isConnected = true;
+        m_packetSize = 0;
         return true;
     }
 
@@ -62,48 +71,140 @@ bool PipeClient::IsConnected() const
     return m_isConnected;
 }
 
-bool PipeClient::Read(VRDataPacket& packet)
+// Overlapped read of exactly `size` bytes. Waits on the read event and the cancel
+// event together; cancellation aborts the I/O and reports failure.
+bool PipeClient::ReadExact(void* buffer, DWORD size)
 {
-    if (!m_isConnected) {
-        return false;
-    }
+    ResetEvent(m_readEvent);
+    m_overlapped.Offset = 0;
+    m_overlapped.OffsetHigh = 0;
+    m_overlapped.hEvent = m_readEvent;
 
-    // Read the raw packet data from Python (88 bytes)
-    VRDataPacketV2 rawPacket;
     DWORD bytesRead = 0;
-    BOOL result = ReadFile(
-        m_pipeHandle,
-        &rawPacket,
-        sizeof(VRDataPacketV2),  // 88 bytes
-        &bytesRead,
-        NULL);
+    BOOL result = ReadFile(m_pipeHandle, buffer, size, &bytesRead, &m_overlapped);
+    if (!result && GetLastError() == ERROR_IO_PENDING) {
+        HANDLE waitHandles[2] = { m_readEvent, m_cancelEvent };
+        DWORD handleCount = m_cancelEvent ? 2 : 1;
+        DWORD waitResult = WaitForMultipleObjects(handleCount, waitHandles, FALSE, INFINITE);
+
+        if (waitResult != WAIT_OBJECT_0) {
+            // Shutdown requested (or wait failed): abort the read before the buffer goes away
+            CancelIoEx(m_pipeHandle, &m_overlapped);
+            GetOverlappedResult(m_pipeHandle, &m_overlapped, &bytesRead, TRUE);
+            return false;
+        }
+        result = GetOverlappedResult(m_pipeHandle, &m_overlapped, &bytesRead, FALSE);
+    }
 
-    if (!result || bytesRead != sizeof(VRDataPacketV2)) {
+    if (!result || bytesRead != size) {
         if (result) {
-            _MESSAGE("FNVR | Pipe read error: expected %zu bytes, got %lu", sizeof(VRDataPacketV2), bytesRead);
+            _MESSAGE("FNVR | Pipe read error: expected %lu bytes, got %lu", size, bytesRead);
         } else {
             DWORD error = GetLastError();
             if (error != ERROR_BROKEN_PIPE) {
                 _MESSAGE("FNVR | Pipe read failed: error %lu", error);
             }
         }
+        return false;
+    }
+    return true;
+}
+
+// The first packet on a connection decides the wire version (V2 or V3) and thus
+// the packet size used for the rest of the session.
+bool PipeClient::ReadFirstPacket(WirePacket& packet)
+{
+    if (!ReadExact(packet.data, 2)) {
+        Disconnect();
+        return false;
+    }
+
+    unsigned int version = GetWirePacketVersion(packet.data);
+    unsigned int size = GetWirePacketSize(version);
+    if (size == 0) {
+        _MESSAGE("FNVR | Unsupported packet version %u, disconnecting", version);
+        Disconnect();
+        return false;
+    }
+
+    if (!ReadExact(packet.data + 2, size - 2)) {
+        Disconnect();
+        return false;
+    }
+
+    m_packetSize = size;
+    _MESSAGE("FNVR | Tracker uses packet version %u (%u bytes)", version, size);
+    RecordPacket(packet.data, size);
+    return true;
+}
+
+// Read of exactly one packet from Python straight into the caller's slot; waits until one arrives
+bool PipeClient::ReadOne(WirePacket& packet)
+{
+    if (!ReadExact(packet.data, m_packetSize)) {
         Disconnect();
         return false;
     }
+    RecordPacket(packet.data, m_packetSize);
+    return true;
+}
+
+// Reads every whole packet currently queued in one ReadFile and returns the last.
+// Returns nullptr when fewer than two packets were queued (nothing to drain).
+const unsigned char* PipeClient::DrainLatest()
+{
+    const DWORD packetSize = m_packetSize;
+    const unsigned char* latest = nullptr;
+
+    DWORD available = 0;
+    while (PeekNamedPipe(m_pipeHandle, NULL, 0, NULL, &available, NULL) &&
+           available >= (latest ? 1 : 2) * packetSize) {
+        DWORD packets = available / packetSize;
+        if (packets > kMaxDrainPackets) {
+            packets = kMaxDrainPackets;
+        }
+
+        // Whole packets only, so the stream stays aligned on packet boundaries
+        if (!ReadExact(m_drainBuffer, packets * packetSize)) {
+            return nullptr;
+        }
+        for (DWORD i = 0; i < packets; i++) {
+            RecordPacket(m_drainBuffer + i * packetSize, packetSize);
+        }
+
+        m_droppedPackets += latest ? packets : packets - 1;
+        latest = m_drainBuffer + (packets - 1) * packetSize;
+    }
 
-    // Version check
-    if (rawPacket.version != 2) {
-        _MESSAGE("FNVR | Warning: Unexpected packet version %u (expected 2)", rawPacket.version);
+    return latest;
+}
+
+bool PipeClient::Read(WirePacket& packet)
+{
+    if (!m_isConnected) {
+        return false;
     }
 
-    // Convert from wire format to game format
-    ConvertV2ToFull(rawPacket, packet);
+    if (m_packetSize == 0) {
+        if (!ReadFirstPacket(packet)) {
+            return false;
+        }
+    } else {
+        const unsigned char* latest = m_drainMode ? DrainLatest() : nullptr;
+        if (latest) {
+            memcpy(packet.data, latest, m_packetSize);
+        } else if (!ReadOne(packet)) {
+            return false;
+        }
+    }
+    packet.size = m_packetSize;
 
-    // Validate quaternions are normalized
-    float hmd_qlen = packet.hmd_qw*packet.hmd_qw + packet.hmd_qx*packet.hmd_qx + 
-                    packet.hmd_qy*packet.hmd_qy + packet.hmd_qz*packet.hmd_qz;
-    if (hmd_qlen < 0.9f || hmd_qlen > 1.1f) {
-        _MESSAGE("FNVR | Warning: HMD quaternion not normalized: %.3f", hmd_qlen);
+    // A version change mid-stream means we lost packet alignment, so start over
+    // with a fresh connection
+    if (!IsWirePacketValid(packet.data, packet.size)) {
+        _MESSAGE("FNVR | Warning: Unexpected packet version %u mid-stream, reconnecting", GetWirePacketVersion(packet.data));
+        Disconnect();
+        return false;
     }
 
     // Check skeleton visibility periodically
@@ -113,4 +214,4 @@ bool PipeClient::Read(VRDataPacket& packet)
     }
     
     return true;
-} 
\ No newline at end of file
+}
\ No newline at end of file
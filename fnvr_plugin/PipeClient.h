@@ -2,21 +2,49 @@
 
 #include <windows.h>
 #include <string>
-#include "VRDataPacket.h" // Includes both VRDataPacketV2 and VRDataPacket definitions
+#include "VRDataPacket.h" // Includes the V2/V3 wire formats and VRDataPacket definitions
+#include "TrackingSource.h"
 
-class PipeClient
+// Overlapped (asynchronous) named pipe client. Reads complete on an event and every
+// wait also watches an optional cancel event, so a blocked Read() returns as soon as
+// the plugin shuts down instead of waiting for the tracker to send another packet.
+class PipeClient : public ITrackingSource
 {
 public:
     PipeClient(const std::string& pipeName);
     ~PipeClient();
 
-    bool Connect();
-    void Disconnect();
-    bool IsConnected() const;
-    bool Read(VRDataPacket& packet);
+    bool Connect() override;
+    void Disconnect() override;
+    bool IsConnected() const override;
+    bool Read(WirePacket& packet) override;
+    const char* GetName() const override { return "named pipe"; }
+
+    // Drain mode: when more than one packet is queued, read them all in one call
+    // and keep only the newest, so a backlog never turns into tracking lag.
+    void SetDrainMode(bool enabled) { m_drainMode = enabled; }
+    bool GetDrainMode() const { return m_drainMode; }
+    uint32_t GetDroppedPackets() const override { return m_droppedPackets; }
+
+    // Manual-reset event that aborts any pending wait (owned by the caller)
+    void SetCancelEvent(HANDLE cancelEvent) { m_cancelEvent = cancelEvent; }
+
+    static const DWORD kMaxDrainPackets = 32;
 
 private:
+    bool ReadExact(void* buffer, DWORD size);
+    bool ReadFirstPacket(WirePacket& packet);
+    bool ReadOne(WirePacket& packet);
+    const unsigned char* DrainLatest();
+
     std::string m_pipeName;
     HANDLE m_pipeHandle;
+    HANDLE m_readEvent;
+    HANDLE m_cancelEvent;
+    OVERLAPPED m_overlapped;
     bool m_isConnected;
+    bool m_drainMode;
+    uint32_t m_droppedPackets;
+    unsigned int m_packetSize;  // Wire packet size for this connection, 0 until the first header is read
+    unsigned char m_drainBuffer[kMaxDrainPackets * VR_MAX_WIRE_PACKET_SIZE];
 }; 
\ No newline at end of file
@@ -8,14 +8,26 @@
 #include <cstring>
 #include <vector>
 #include <string>
-#include <map>
 #include <chrono>
 #include <fstream>
 #include <cmath>
 
 // Include FNVR modules
-#include "VRDataPacket.h"
+#include "VRPacketView.h"
+#include "PoseMailbox.h"
+#include "PoseJitterBuffer.h"
+#include "FramePacer.h"
+#include "WakeScheduler.h"
+#include "FrameProfiler.h"
+#include "PoseBatch.h"
+#include "SkeletonScan.h"
+#include "TrackingSource.h"
 #include "PipeClient.h"
+#include "SharedMemoryClient.h"
+#include "UdpTrackingSource.h"
+#include "ReplayTrackingSource.h"
+#include "SessionRecording.h"
+#include "LatencyStats.h"
 #include "VRSystem.h"
 #include "NVCSSkeleton.h"
 #include "FirstPersonBodyFix.h"
@@ -24,6 +36,7 @@
 // NVSE includes
 #include "nvse/PluginAPI.h"
 #include "nvse/CommandTable.h"
+#include "nvse/ParamInfos.h"
 #include "nvse/GameAPI.h"
 #include "nvse/GameObjects.h"
 #include "nvse/GameRTTI.h"
@@ -40,36 +53,112 @@ static IDebugLog gLog("FNVR.log");
 static NVSEMessagingInterface* g_messaging = nullptr;
 static NVSEScriptInterface* g_script = nullptr;
 static const NVSEInterface* g_nvse = nullptr;
+static const UInt32 FNVR_OPCODE_BASE = 0x2000;
 
 // Thread control
 static std::atomic<bool> g_shouldStop(false);
+static HANDLE g_stopEvent = NULL;  // Manual-reset; wakes every cancellable wait on shutdown
 static std::thread* g_pipeThread = nullptr;
 static std::thread* g_updateThread = nullptr;
+static FNVR::WakeScheduler g_updateScheduler;  // Update thread sleeps here: frame deadline or new packet
 
-// VR Data with thread safety
-static VRDataPacket g_currentVRData = {};
-static std::atomic<bool> g_hasNewData(false);
-static CRITICAL_SECTION g_dataLock;
+// Latest raw wire packet handed from the pipe thread to the update thread
+// (wait-free triple buffer); read in place through VRPacketView
+static FNVR::PoseMailbox<WirePacket> g_poseMailbox;
+
+// Recent poses in timestamp order; the apply stage samples them a playout delay
+// behind the tracker instead of taking whatever arrived last
+static FNVR::PoseJitterBuffer g_jitterBuffer;
+
+// Motion-to-apply latency: packet timestamp -> bones written, per tracker session
+static FNVR::ClockSync g_clockSync;
+static FNVR::LatencyHistogram g_applyLatency;
+static FNVR::LatencyHistogram g_applyCost;  // Time spent applying, per frame/update
+static bool g_measureLatency = true;  // Off for replays (their timestamps are from the past)
 
 // Pipe connection state
 static bool g_isPipeConnected = false;
 static int g_pipeReconnectAttempts = 0;
+static const DWORD RECONNECT_INTERVAL_MS = 50;  // Tracker restarts are picked up within this
 
-// Bone cache for performance
-struct BoneCache {
+// Late latch: the bones the frame's apply wrote are re-posed with the newest tracker
+// data from a hook on the game-mode render call, after the game update has run.
+// Without the hook (disabled, not frame-synced, or the call site is not what we
+// expect) the poses written at the top of the frame are what gets rendered.
+struct LateLatchTargets {
+    NiNode* head;
+    NiNode* rightHand;
+    NiNode* weapon;
+    bool monotonic;
+    bool pending;  // Set by this frame's apply, consumed by the latch
+};
+static LateLatchTargets g_latchTargets = {};
+static bool g_lateLatchEnabled = true;
+static UInt32 g_lateLatchHookTarget = 0;        // Call target we chained in front of; 0 = no hook
+static const UInt32 kLateLatchCallSite = 0x870244;  // Main loop: call 0x8706B0 (render, game mode)
+static FNVR::LatencyHistogram g_latchLatency;   // Pose age at latch time
+static UInt32 g_latchedFrames = 0;
+static UInt32 g_appliedFrames = 0;
+
+// Bone cache for performance: one slot per NVCS bone, so a per-frame lookup is a
+// single indexed load (no string building, no tree walk)
+struct BoneCacheEntry {
     NiNode* node;
-    std::string name;
     NiTransform originalTransform;
 };
-static std::map<std::string, BoneCache> g_boneCache;
-static bool g_boneCacheValid = false;
+
+// What a bone cache was built from, compared every frame: if any of it changes the
+// cached NiNode pointers may point into a freed skeleton (model reload, cell
+// transition), so the cache is rebuilt before it is used
+struct SkeletonSignature {
+    NiNode* root;
+    NiAVObject* firstChild;  // Replaced when the model under the root is reloaded
+    UInt32 childCount;
+    TESObjectCELL* cell;
+};
+
+// The player has two skeletons, each with its own cache. Both are kept current every
+// frame whether shown or not, so switching view just picks the other table.
+enum SkeletonView {
+    kView_FirstPerson = 0,
+    kView_ThirdPerson,
+    kView_Count
+};
+
+struct BoneCache {
+    BoneCacheEntry bones[FNVR::NVCSSkeleton::NVCS_BONE_COUNT];
+    SkeletonSignature signature;
+    int scannedBones;  // Found by the last build; 0 = not built yet
+    bool valid;
+};
+static BoneCache g_boneCaches[kView_Count] = {};
+static bool g_poseBothSkeletons = false;  // Also pose the skeleton of the view not shown
+static UInt32 g_boneCacheRebuilds = 0;
+
+// Node names are NiFixedStrings: one shared copy per distinct string, so a wanted name
+// interned once can be matched by pointer. The returned reference is never released,
+// which keeps those pointers valid for the life of the process.
+typedef const char* (__cdecl *GetFixedStringFn)(const char* str);
+static const GetFixedStringFn GetFixedString = (GetFixedStringFn)0xA5B690;
+static FNVR::LatencyHistogram g_boneCacheCost;  // Time per rebuild
 
 // Cached VorpX data
 static HmdVector3_t g_cachedVorpxHeadPos = {0, 0, 0};
 
-// Timing
-static auto g_lastUpdateTime = std::chrono::steady_clock::now();
-static const int UPDATE_INTERVAL_MS = 16; // ~60 FPS
+// Timing: measured game frame interval; drives the update thread's cadence and the
+// prediction horizon
+static FNVR::FramePacer g_framePacer;
+static const int MAX_IDLE_FRAMES = 4;  // Update thread: re-apply at least this often without new packets
+static int g_predictionPercent = 0;  // Horizon in percent of a frame; 0 = no prediction
+double GetPredictionHorizon();
+
+// Where bones are written: 0 = free-running update thread at the measured frame rate,
+// 1 = on the main thread once per game frame (kMessage_MainGameLoop)
+enum ApplyMode {
+    kApply_UpdateThread = 0,
+    kApply_FrameSync = 1
+};
+static int g_applyMode = kApply_FrameSync;
 
 // Global configuration variables
 static float g_positionScale = 50.0f;
@@ -77,6 +166,28 @@ static bool g_enableHeadTracking = true;
 static bool g_enableHandTracking = true;
 static bool g_enableLogging = true;
 
+// Tracker transport: 0 = named pipe, 1 = shared-memory ring, 2 = loopback UDP, 3 = replay file
+enum TrackerTransport {
+    kTransport_Pipe = 0,
+    kTransport_SharedMemory = 1,
+    kTransport_Udp = 2,
+    kTransport_Replay = 3
+};
+static int g_trackerTransport = kTransport_Pipe;
+static bool g_pipeDrainMode = true;  // Latest-wins: skip packets queued behind a newer one
+static int g_udpPort = UdpTrackingSource::kDefaultPort;
+static char g_replayFile[MAX_PATH] = "";
+static int g_replaySpeedPercent = 100;  // 0 = as fast as possible
+static bool g_replayLoop = false;
+static int g_replayStartMs = 0;         // Session recordings: skip this far in
+
+// Pose smoothing: jitter buffer depth in tracker samples (0 = apply newest packet as is)
+static int g_jitterBufferDepth = 2;
+
+// Session recording of the raw tracker stream
+static bool g_recordSession = false;
+static char g_recordFile[MAX_PATH] = "";
+
 // VorpX-specific params
 static float g_vorpxScaleFactor = 1.0f;
 static float g_vorpxLatencyOffset = 0.0f;
@@ -92,6 +203,22 @@ void LoadConfig() {
     g_enableHeadTracking = GetPrivateProfileIntA("General", "EnableHeadTracking", 1, iniPath) != 0;
     g_enableHandTracking = GetPrivateProfileIntA("General", "EnableHandTracking", 1, iniPath) != 0;
     g_enableLogging = GetPrivateProfileIntA("General", "EnableLogging", 1, iniPath) != 0;
+    g_trackerTransport = GetPrivateProfileIntA("Transport", "Mode", kTransport_Pipe, iniPath);
+    g_pipeDrainMode = GetPrivateProfileIntA("Transport", "DrainMode", 1, iniPath) != 0;
+    g_udpPort = GetPrivateProfileIntA("Transport", "UdpPort", UdpTrackingSource::kDefaultPort, iniPath);
+    GetPrivateProfileStringA("Transport", "ReplayFile", "Data\\NVSE\\Plugins\\FNVR_session.fnvrec", g_replayFile, MAX_PATH, iniPath);
+    g_replaySpeedPercent = GetPrivateProfileIntA("Transport", "ReplaySpeedPercent", 100, iniPath);
+    g_replayLoop = GetPrivateProfileIntA("Transport", "ReplayLoop", 0, iniPath) != 0;
+    g_replayStartMs = GetPrivateProfileIntA("Transport", "ReplayStartMs", 0, iniPath);
+    g_applyMode = GetPrivateProfileIntA("Timing", "ApplyMode", kApply_FrameSync, iniPath) == kApply_UpdateThread
+        ? kApply_UpdateThread : kApply_FrameSync;
+    g_lateLatchEnabled = GetPrivateProfileIntA("Timing", "LateLatch", 1, iniPath) != 0;
+    g_poseBothSkeletons = GetPrivateProfileIntA("Skeleton", "PoseBothSkeletons", 0, iniPath) != 0;
+    g_predictionPercent = GetPrivateProfileIntA("Timing", "PredictionPercent", 0, iniPath);
+    g_jitterBufferDepth = GetPrivateProfileIntA("Smoothing", "JitterBufferDepth", 2, iniPath);
+    g_jitterBuffer.SetDepth(g_jitterBufferDepth > 0 ? (UInt32)g_jitterBufferDepth : 0);
+    g_recordSession = GetPrivateProfileIntA("Recording", "Enabled", 0, iniPath) != 0;
+    GetPrivateProfileStringA("Recording", "File", "Data\\NVSE\\Plugins\\FNVR_session.fnvrec", g_recordFile, MAX_PATH, iniPath);
 
     // VorpX-specific params
     g_vorpxScaleFactor = (float)GetPrivateProfileIntA("VorpX", "ScaleFactor", 1, iniPath);
@@ -100,8 +227,8 @@ void LoadConfig() {
     g_poleVector.v[1] = (float)GetPrivateProfileIntA("IK", "PoleVectorY", 0, iniPath);
     g_poleVector.v[2] = (float)GetPrivateProfileIntA("IK", "PoleVectorZ", -1, iniPath);
 
-    Log("Config loaded: PositionScale=%.1f, HeadTracking=%d, HandTracking=%d, Logging=%d, VorpXScale=%.1f, LatencyOffset=%.1f",
-        g_positionScale, g_enableHeadTracking, g_enableHandTracking, g_enableLogging, g_vorpxScaleFactor, g_vorpxLatencyOffset);
+    Log("Config loaded: PositionScale=%.1f, HeadTracking=%d, HandTracking=%d, Logging=%d, VorpXScale=%.1f, LatencyOffset=%.1f, Transport=%d, ApplyMode=%d",
+        g_positionScale, g_enableHeadTracking, g_enableHandTracking, g_enableLogging, g_vorpxScaleFactor, g_vorpxLatencyOffset, g_trackerTransport, g_applyMode);
 }
 
 // Safe memory access functions
@@ -155,79 +282,187 @@ void Log(const char* fmt, ...) {
     _MESSAGE("%s", buffer);
 }
 
-// Find bone recursively with cache
-NiNode* FindBone(NiNode* root, const char* boneName) {
-    if (!root || !boneName) return nullptr;
-    
-    // Check cache first
-    auto it = g_boneCache.find(boneName);
-    if (it != g_boneCache.end() && g_boneCacheValid) {
-        return it->second.node;
+// NiNode access for FNVR::ScanSkeleton; only NiNode children are descended into
+struct NiNodeScanTraits {
+    static const char* Name(NiNode* node) { return node->m_pcName; }
+    static UInt32 ChildCount(NiNode* node) {
+        if (!node->m_children.m_data) return 0;
+        UInt32 size = node->m_children.m_size;
+        return size < node->m_children.m_uiMaxSize ? size : node->m_children.m_uiMaxSize;
     }
-    
-    // Check current node
-    if (root->m_pcName && _stricmp(root->m_pcName, boneName) == 0) {
-        // Add to cache
-        BoneCache cache;
-        cache.node = root;
-        cache.name = boneName;
-        cache.originalTransform = root->m_localTransform;
-        g_boneCache[boneName] = cache;
-        return root;
-    }
-    
-    // Search children with safety checks
-    if (root->m_children.m_data) {
-        for (UInt32 i = 0; i < root->m_children.m_size; i++) {
-            if (i >= root->m_children.m_uiMaxSize) {
-                Log("FindBone: Array bounds warning (i=%d, max=%d)", i, root->m_children.m_uiMaxSize);
-                break;
-            }
-            
-            NiAVObject* child = root->m_children.m_data[i];
-            if (child && child->GetNiRTTI() && child->GetNiRTTI()->IsKindOf(NiRTTI_NiNode)) {
-                NiNode* found = FindBone(static_cast<NiNode*>(child), boneName);
-                if (found) return found;
-            }
+    static NiNode* Child(NiNode* node, UInt32 i) {
+        NiAVObject* child = node->m_children.m_data[i];
+        if (child && child->GetNiRTTI() && child->GetNiRTTI()->IsKindOf(NiRTTI_NiNode)) {
+            return static_cast<NiNode*>(child);
         }
+        return nullptr;
     }
-    
-    return nullptr;
+};
+
+// Cached bone, or nullptr if it wasn't found when the cache was built
+inline NiNode* GetCachedBone(const BoneCache& cache, FNVR::NVCSSkeleton::NVCSBone bone) {
+    return cache.bones[bone].node;
 }
 
 // Clear bone cache
-void ClearBoneCache() {
-    g_boneCache.clear();
-    g_boneCacheValid = false;
+void ClearBoneCache(BoneCache& cache) {
+    memset(cache.bones, 0, sizeof(cache.bones));
+    cache.valid = false;
+}
+
+// Cheap per-frame fingerprint of one of the player's skeletons
+SkeletonSignature ReadSkeletonSignature(NiNode* root, TESObjectCELL* cell) {
+    SkeletonSignature signature = {};
+    signature.root = root;
+    signature.cell = cell;
+    if (root && root->m_children.m_data) {
+        signature.childCount = root->m_children.m_size;
+        signature.firstChild = signature.childCount ? root->m_children.m_data[0] : nullptr;
+    }
+    return signature;
+}
+
+bool SameSkeleton(const SkeletonSignature& a, const SkeletonSignature& b) {
+    return a.root == b.root && a.firstChild == b.firstChild && a.childCount == b.childCount &&
+        a.cell == b.cell;
 }
 
-// Build bone cache for all NVCS bones
-void BuildBoneCache(NiNode* root) {
+// Build bone cache for all NVCS bones in one pass over the skeleton
+void BuildBoneCache(BoneCache& cache, NiNode* root) {
     if (!root) return;
+    FNVR_PROFILE_SCOPE(FNVR::kStage_BoneCacheBuild);
+    
+    typedef FNVR::NVCSSkeleton NVCSSkeleton;
+    static FNVR::BoneNameTable nvcsNames;
+    static bool nvcsNamesFailed = false;  // Both caches retry every frame: log it once
+    if (nvcsNamesFailed) return;
+    if (!nvcsNames.IsBuilt()) {
+        const char* names[NVCSSkeleton::NVCS_BONE_COUNT];
+        for (int i = 0; i < NVCSSkeleton::NVCS_BONE_COUNT; i++) {
+            names[i] = NVCSSkeleton::GetBoneName((NVCSSkeleton::NVCSBone)i);
+        }
+        if (!nvcsNames.Build(names, NVCSSkeleton::NVCS_BONE_COUNT)) {
+            Log("ERROR: Could not build the NVCS bone name table; bone tracking is off");
+            nvcsNamesFailed = true;
+            return;
+        }
+        for (int i = 0; i < NVCSSkeleton::NVCS_BONE_COUNT; i++) {
+            nvcsNames.SetInterned(i, GetFixedString(names[i]));
+        }
+    }
     
     Log("Building bone cache...");
-    ClearBoneCache();
+    ClearBoneCache(cache);
+    
+    // Exact-case names match by pointer; the case-insensitive pass only runs when that
+    // finds fewer bones than the last build of this skeleton did
+    NiNode* nodes[NVCSSkeleton::NVCS_BONE_COUNT];
+    int found = FNVR::ScanSkeleton<NiNodeScanTraits>(root, nvcsNames, nodes,
+        cache.scannedBones > 0 ? cache.scannedBones : -1);
+    cache.scannedBones = found;
+    for (int i = 0; i < NVCSSkeleton::NVCS_BONE_COUNT; i++) {
+        if (nodes[i]) {
+            cache.bones[i].node = nodes[i];
+            cache.bones[i].originalTransform = nodes[i]->m_localTransform;
+        }
+    }
     
-    const char* importantBones[] = {
-        "Bip01", "Bip01 Head", "Bip01 Neck", "Bip01 Neck1",
-        "Bip01 R Hand", "Bip01 L Hand", 
-        "Bip01 R Forearm", "Bip01 L Forearm",
-        "Bip01 R UpperArm", "Bip01 L UpperArm",
-        "Weapon", "ProjectileNode"
-    };
+    cache.valid = true;
+    Log("Bone cache built with %d of %d bones", found, (int)NVCSSkeleton::NVCS_BONE_COUNT);
+}
+
+// Keep one view's cache in step with its skeleton; a rebuild is only paid when the
+// skeleton changed. Returns whether the cache can be used this frame.
+bool RefreshBoneCache(SkeletonView view, NiNode* root, TESObjectCELL* cell) {
+    BoneCache& cache = g_boneCaches[view];
+    if (!root) {
+        cache.valid = false;  // Rebuilt when the skeleton comes back
+        return false;
+    }
     
-    for (const char* boneName : importantBones) {
-        FindBone(root, boneName);
+    const SkeletonSignature signature = ReadSkeletonSignature(root, cell);
+    if (cache.valid && SameSkeleton(signature, cache.signature)) {
+        return true;
     }
     
-    g_boneCacheValid = true;
-    Log("Bone cache built with %d bones", g_boneCache.size());
+    if (cache.valid) {
+        Log("Skeleton changed (%s, root %p), rebuilding bone cache",
+            view == kView_FirstPerson ? "first person" : "third person", root);
+    }
+    auto buildStart = std::chrono::high_resolution_clock::now();
+    BuildBoneCache(cache, root);
+    auto buildEnd = std::chrono::high_resolution_clock::now();
+    g_boneCacheCost.Record(std::chrono::duration<double>(buildEnd - buildStart).count());
+    g_boneCacheRebuilds++;
+    cache.signature = signature;
+    return cache.valid;
 }
 
-// Thread-safe pipe reading thread with error handling
-void PipeThreadFunc() {
-    Log("Pipe thread started");
-    PipeClient pipeClient("\\\\.\\pipe\\FNVRTracker");
+// Signal every thread to stop and wake any cancellable wait immediately
+void RequestStop() {
+    g_shouldStop = true;
+    if (g_stopEvent) {
+        SetEvent(g_stopEvent);
+    }
+    g_updateScheduler.Stop();
+}
+
+// Sleep that returns early when shutdown is requested. Returns false if stopping.
+bool WaitOrStop(DWORD timeoutMs) {
+    if (!g_stopEvent) {
+        Sleep(timeoutMs);
+        return !g_shouldStop;
+    }
+    return WaitForSingleObject(g_stopEvent, timeoutMs) == WAIT_TIMEOUT;
+}
+
+// Session summary of the motion-to-apply latency histogram
+void LogLatencySummary() {
+    if (g_measureLatency && g_applyLatency.GetCount() > 0) {
+        char summary[256];
+        g_applyLatency.FormatSummary(summary, sizeof(summary));
+        Log("Session latency (packet -> bones): %s, transport floor %.2fms", summary, g_clockSync.GetTransportFloor() * 1e3);
+    }
+    if (g_measureLatency && g_latchLatency.GetCount() > 0) {
+        char summary[256];
+        g_latchLatency.FormatSummary(summary, sizeof(summary));
+        Log("Late-latched pose age: %s", summary);
+    }
+    if (g_applyCost.GetCount() > 0) {
+        char summary[256];
+        g_applyCost.FormatSummary(summary, sizeof(summary));
+        Log("Apply cost per %s: %s", g_applyMode == kApply_FrameSync ? "frame" : "update", summary);
+    }
+    if (g_boneCacheCost.GetCount() > 0) {
+        char summary[256];
+        g_boneCacheCost.FormatSummary(summary, sizeof(summary));
+        Log("Bone cache: %u rebuilds, cost %s", g_boneCacheRebuilds, summary);
+    }
+    if (g_applyMode == kApply_UpdateThread) {
+        Log("Update thread: %.1f wakeups/s (%llu total)", g_updateScheduler.GetWakeupsPerSecond(),
+            (unsigned long long)g_updateScheduler.GetWakeups());
+    }
+#ifdef FNVR_ENABLE_PROFILER
+    Log("Apply pipeline stages:");
+    for (int stage = 0; stage < FNVR::kStage_Count; stage++) {
+        char line[128];
+        FNVR::FrameProfiler::FormatStage((FNVR::ProfileStage)stage, line, sizeof(line));
+        Log("  %s", line);
+    }
+#endif
+    Log("Frame pacing: %.2fms (%.0f fps), %u outlier frames ignored, prediction %.1fms",
+        g_framePacer.GetFrameInterval() * 1e3, g_framePacer.GetFrameRate(), g_framePacer.GetRejectedCount(),
+        GetPredictionHorizon() * 1e3);
+    if (g_jitterBuffer.GetDepth() > 0) {
+        Log("Jitter buffer: depth %u adds %.1fms (tracker interval %.2fms, %u out-of-order samples dropped)",
+            g_jitterBuffer.GetDepth(), g_jitterBuffer.GetPlayoutDelay() * 1e3,
+            g_jitterBuffer.GetSampleInterval() * 1e3, g_jitterBuffer.GetOutOfOrderCount());
+    }
+}
+
+// Tracker read loop, shared by every transport
+void RunTrackerLoop(ITrackingSource& pipeClient) {
+    UInt32 reportedDrops = 0;
     
     while (!g_shouldStop) {
         // Connection management with retry logic
@@ -237,59 +472,118 @@ void PipeThreadFunc() {
             if (!pipeClient.Connect()) {
                 g_pipeReconnectAttempts++;
                 
-                // Log every 10 attempts to avoid spam
-                if (g_pipeReconnectAttempts % 10 == 1) {
-                    Log("Pipe connection attempt %d failed, retrying...", g_pipeReconnectAttempts);
+                // Log every ~10 seconds of attempts to avoid spam
+                if (g_pipeReconnectAttempts % 200 == 1) {
+                    Log("%s connection attempt %d failed, retrying...", pipeClient.GetName(), g_pipeReconnectAttempts);
                 }
                 
-                Sleep(1000); // Wait 1 second before retry
+                WaitOrStop(RECONNECT_INTERVAL_MS);
                 continue;
             }
             
-            // Connection successful
+            // Connection successful: new session, fresh latency statistics
             g_isPipeConnected = true;
             g_pipeReconnectAttempts = 0;
-            Log("Pipe connected successfully");
+            g_clockSync.Reset();
+            g_applyLatency.RequestReset();
+            g_applyCost.RequestReset();
+            g_latchLatency.RequestReset();
+            g_jitterBuffer.Reset();
+            Log("Tracker connected via %s", pipeClient.GetName());
         }
         
-        // Read data with error handling
-        VRDataPacket data;
+        // Read straight into the mailbox's producer slot; only published if valid
+        WirePacket& data = g_poseMailbox.BeginWrite();
         if (pipeClient.Read(data)) {
-            // Validate data before storing
-            bool dataValid = true;
-            
-            // Basic validation: check if quaternions are normalized
-            float hmdQLen = data.hmd_qw*data.hmd_qw + data.hmd_qx*data.hmd_qx + 
-                           data.hmd_qy*data.hmd_qy + data.hmd_qz*data.hmd_qz;
-            if (hmdQLen < 0.9f || hmdQLen > 1.1f) {
+            // Validate data before storing (quaternions must be normalized)
+            float hmdQLen = 0.0f;
+            VRPacketView view(data);
+            if (IsTrackingPacketValid(view, &hmdQLen)) {
+                g_clockSync.AddSample(view.GetTimestamp(), view.HasMonotonicTimestamp());
+                g_jitterBuffer.Push(view);
+                g_poseMailbox.Publish();
+                if (g_applyMode == kApply_UpdateThread) {
+                    g_updateScheduler.NotifyNewData();
+                }
+            } else {
                 Log("Warning: Invalid HMD quaternion length: %.3f", hmdQLen);
-                dataValid = false;
             }
             
-            if (dataValid) {
-                // Thread-safe data update
-                EnterCriticalSection(&g_dataLock);
-                g_currentVRData = data;
-                g_hasNewData = true;
-                LeaveCriticalSection(&g_dataLock);
+            // Stale packets skipped by latest-wins reads (log every 120 to avoid spam)
+            UInt32 dropped = pipeClient.GetDroppedPackets();
+            if (dropped - reportedDrops >= 120) {
+                Log("Tracker backlog: skipped %u stale packets so far", dropped);
+                reportedDrops = dropped;
             }
-        } else {
-            // Read failed - connection lost
-            Log("Pipe read failed, disconnecting");
+        } else if (!g_shouldStop) {
+            // Read failed - connection lost; reconnect on the next iteration
+            Log("%s read failed, disconnecting", pipeClient.GetName());
+            LogLatencySummary();
             pipeClient.Disconnect();
             g_isPipeConnected = false;
-            Sleep(100); // Brief pause before reconnection attempt
         }
     }
     
     // Cleanup
+    LogLatencySummary();
     pipeClient.Disconnect();
     g_isPipeConnected = false;
+}
+
+// Thread-safe pipe reading thread with error handling
+void PipeThreadFunc() {
+    Log("Pipe thread started");
+    
+    ITrackingSource* source = nullptr;
+    switch (g_trackerTransport) {
+        case kTransport_SharedMemory:
+            source = new SharedMemoryClient("FNVRTracker");
+            break;
+        case kTransport_Udp:
+            source = new UdpTrackingSource((uint16_t)g_udpPort);
+            break;
+        case kTransport_Replay: {
+            ReplayTrackingSource* replay = new ReplayTrackingSource(g_replayFile, g_replaySpeedPercent / 100.0f, g_replayLoop);
+            if (g_replayStartMs > 0 && replay->Connect() && !replay->SeekToTime(g_replayStartMs / 1000.0)) {
+                Log("Replay start offset ignored (only session recordings are seekable)");
+            }
+            source = replay;
+            break;
+        }
+        default: {
+            PipeClient* pipeClient = new PipeClient("\\\\.\\pipe\\FNVRTracker");
+            pipeClient->SetDrainMode(g_pipeDrainMode);
+            pipeClient->SetCancelEvent(g_stopEvent);
+            source = pipeClient;
+            break;
+        }
+    }
+    
+    // Recording a replay would only duplicate its input file
+    FNVR::SessionRecorder recorder;
+    if (g_recordSession && g_trackerTransport != kTransport_Replay && recorder.Open(g_recordFile)) {
+        Log("Recording tracker session to %s", g_recordFile);
+        source->SetRecorder(&recorder);
+    }
+    
+    g_measureLatency = g_trackerTransport != kTransport_Replay;
+    Log("Using %s transport", source->GetName());
+    source->SetStopFlag(&g_shouldStop);
+    RunTrackerLoop(*source);
+    delete source;
+    
+    if (recorder.IsOpen()) {
+        Log("Session recording finished: %u packets", recorder.GetRecordCount());
+        recorder.Close();
+    }
+    
     Log("Pipe thread stopped");
 }
 
 // Check if game is in a safe state for VR updates
 bool IsGameStateValid() {
+    FNVR_PROFILE_SCOPE(FNVR::kStage_GameState);
+    
     // Check if we're in the main game world, not in menus or loading
     
     // Method 1: Check common menu states
@@ -320,294 +614,486 @@ bool IsGameStateValid() {
     return true;
 }
 
-// Apply VR data to skeleton with comprehensive safety checks
-void ApplyVRDataToSkeleton() {
-    // === STAGE 1: Game State Validation ===
-    if (!IsGameStateValid()) {
-        return; // Not safe to update
+// How far ahead of "now" poses are predicted: a share of the measured frame time
+double GetPredictionHorizon() {
+    return g_predictionPercent > 0 ? g_framePacer.GetFrameInterval() * g_predictionPercent / 100.0 : 0.0;
+}
+
+// Whether the pose to apply moves from frame to frame without a new packet: the
+// jitter buffer interpolates and prediction extrapolates to each frame's own time
+bool PosesChangeBetweenPackets() {
+    return g_jitterBuffer.GetDepth() > 0 || GetPredictionHorizon() > 0.0;
+}
+
+// Poses to apply now: sampled from the jitter buffer when it is enabled or a
+// prediction horizon is set, otherwise the packet's own.
+// out.timestamp is the tracker time the poses represent.
+void SelectPoses(const VRPacketView& vrData, FNVR::PoseSample& out) {
+    FNVR_PROFILE_SCOPE(FNVR::kStage_PoseSelect);
+    const double horizon = GetPredictionHorizon();
+    if (g_jitterBuffer.GetDepth() > 0 || horizon > 0.0) {
+        double trackerNow = FNVR::ClockSync::Now(vrData.HasMonotonicTimestamp()) - g_clockSync.GetTransportFloor();
+        double target = trackerNow - g_jitterBuffer.GetPlayoutDelay() + horizon;
+        // Extrapolate at most the horizon plus one late packet
+        double maxExtrapolation = horizon > 0.0 ? horizon + g_jitterBuffer.GetSampleInterval() : 0.0;
+        if (g_jitterBuffer.Sample(target, out, maxExtrapolation)) {
+            return;
+        }
     }
+    out.timestamp = vrData.GetTimestamp();
+    out.poses[FNVR::kPose_Hmd] = vrData.Hmd();
+    out.poses[FNVR::kPose_Right] = vrData.Right();
+    out.poses[FNVR::kPose_Left] = vrData.Left();
+}
+
+// Poses to apply now, converted to game space for every device in one pass
+void ConvertSelectedPoses(const FNVR::PoseSample& poses, FNVR::ConvertedPoseBatch& out) {
+    FNVR_PROFILE_SCOPE(FNVR::kStage_PoseConversion);
     
-    // === STAGE 2: Player Validation ===
+    // OpenVR: Y-up, -Z forward (meters); Gamebryo: Z-up, Y forward (game units)
+    // Frames and the mapping: CoordinateFrames.h
+    FNVR::PoseBatch batch;
+    FNVR::LoadPoseBatch(poses, batch);
+    FNVR::ConvertPoseBatch(batch, g_positionScale, out);
+}
+
+// Write one converted device pose into a bone's local transform (no Update)
+void SetBoneFromPose(NiNode* bone, const FNVR::ConvertedPoseBatch& poses, FNVR::PoseDevice device,
+                     float offsetX, float offsetY, float offsetZ) {
+    // Apply position offsets from config
+    bone->m_localTransform.pos.x = poses.px[device] + offsetX;
+    bone->m_localTransform.pos.y = poses.py[device] + offsetY;
+    bone->m_localTransform.pos.z = poses.pz[device] + offsetZ;
+    poses.GetRotation(device, &bone->m_localTransform.rot.data[0][0]);
+}
+
+// Validated player skeleton roots for this frame (nullptr where a skeleton is not
+// loaded) and which of them is shown. False if the shown one is missing.
+bool GetPlayerSkeletonRoots(NiNode* roots[kView_Count], SkeletonView& shownView, TESObjectCELL*& cell) {
+    FNVR_PROFILE_SCOPE(FNVR::kStage_PlayerChecks);
+    
+    // Player validation
     PlayerCharacter* player = PlayerCharacter::GetSingleton();
     if (!player) {
         Log("Safety check failed: player is null");
-        return;
+        return false;
     }
     
     // Check if player is dead
     if (player->GetDead()) {
         Log("Safety check: player is dead, skipping updates");
-        return;
+        return false;
     }
     
     // Check if player has a valid parent cell (is in world)
     if (!player->parentCell) {
         Log("Safety check failed: player has no parent cell");
-        return;
+        return false;
     }
     
     // Check if player has process data
     if (!player->process) {
         Log("Safety check failed: player->process is null");
-        return;
+        return false;
     }
     
-    // === STAGE 3: Get Skeleton Root with Safety ===
-    NiNode* skeletonRoot = nullptr;
+    // Skeleton roots with safety
+    roots[kView_FirstPerson] = player->firstPerson ? player->firstPerson->rootNode : nullptr;
+    roots[kView_ThirdPerson] = player->niNode;
+    shownView = player->IsThirdPerson() ? kView_ThirdPerson : kView_FirstPerson;
+    cell = player->parentCell;
     
-    if (!player->IsThirdPerson()) {
-        // First person - check if firstPerson exists
-        if (player->firstPerson && player->firstPerson->rootNode) {
-            skeletonRoot = player->firstPerson->rootNode;
-        } else {
+    if (!roots[shownView]) {
+        if (shownView == kView_FirstPerson) {
             Log("Safety check: firstPerson or its rootNode is null");
-            return;
-        }
-    } else {
-        // Third person
-        if (player->niNode) {
-            skeletonRoot = player->niNode;
         } else {
             Log("Safety check: player->niNode is null");
-            return;
         }
+        return false;
     }
-    
-    if (!skeletonRoot) {
-        Log("Safety check failed: skeletonRoot is null after checks");
-        return;
-    }
-    
-    // Ensure bone cache is valid
-    if (!g_boneCacheValid) {
-        BuildBoneCache(skeletonRoot);
-    }
-    
-    // === STAGE 4: Copy VR Data Thread-Safely ===
-    VRDataPacket vrData;
-    bool hasData = false;
-    
-    EnterCriticalSection(&g_dataLock);
-    if (g_hasNewData) {
-        vrData = g_currentVRData;
-        hasData = true;
-        g_hasNewData = false;
-        
-        // Debug: Log data reception occasionally
-        static int dataFrameCount = 0;
-        if (++dataFrameCount % 300 == 0) { // Every 5 seconds at 60fps
-            Log("VR data received: HMD pos(%.2f,%.2f,%.2f) rot(%.2f,%.2f,%.2f,%.2f)",
-                vrData.hmd_px, vrData.hmd_py, vrData.hmd_pz,
-                vrData.hmd_qw, vrData.hmd_qx, vrData.hmd_qy, vrData.hmd_qz);
-        }
-    }
-    LeaveCriticalSection(&g_dataLock);
-    
-    if (!hasData) {
-        static int noDataCount = 0;
-        if (++noDataCount % 600 == 0) { // Log every 10 seconds
-            Log("Warning: No new VR data available (pipe connected: %s)", 
-                g_isPipeConnected ? "yes" : "no");
-        }
-        return;
-    }
-    
+    return true;
+}
+
+// Writes head, right hand and weapon of one skeleton and collects them for the late
+// latch. False if a tracked bone has come loose from the skeleton (frame abandoned).
+bool PoseSkeleton(const BoneCache& cache, const FNVR::ConvertedPoseBatch& poses, LateLatchTargets& latch) {
     // Apply head tracking with safety checks
     if (g_enableHeadTracking) {
-        NiNode* headBone = FindBone(skeletonRoot, "Bip01 Head");
+        NiNode* headBone;
+        {
+            FNVR_PROFILE_SCOPE(FNVR::kStage_BoneLookup);
+            headBone = GetCachedBone(cache, FNVR::NVCSSkeleton::NVCS_BIP01_HEAD);
+        }
         if (!headBone) {
             Log("Warning: Could not find Bip01 Head bone");
         } else {
             // Additional validation before modifying
             if (!headBone->m_parent) {
                 Log("Warning: Head bone has no parent, skipping");
-                return;
-            }
-            // Convert VR coordinates to game coordinates using proper transformation
-            // OpenVR: Right-handed, Y-up, -Z forward (meters)
-            // Gamebryo: Left-handed, Z-up, Y forward (game units)
-            
-            // Position conversion
-            float gameX =  vrData.hmd_px * g_positionScale;  // X -> X
-            float gameY = -vrData.hmd_pz * g_positionScale;  // -Z -> Y
-            float gameZ =  vrData.hmd_py * g_positionScale;  // Y -> Z
-            
-            // Apply position offsets from config
-            headBone->m_localTransform.pos.x = gameX + g_positionOffsetX;
-            headBone->m_localTransform.pos.y = gameY + g_positionOffsetY;
-            headBone->m_localTransform.pos.z = gameZ + g_positionOffsetZ;
-            
-            // Quaternion conversion for rotation
-            // OpenVR to Gamebryo requires -90 degree rotation around X axis
-            const float r_sqrt2_inv = 0.7071067811865476f; // 1/sqrt(2)
-            
-            float game_qw = (vrData.hmd_qw + vrData.hmd_qx) * r_sqrt2_inv;
-            float game_qx = (vrData.hmd_qx - vrData.hmd_qw) * r_sqrt2_inv;
-            float game_qy = (vrData.hmd_qy + vrData.hmd_qz) * r_sqrt2_inv;
-            float game_qz = (vrData.hmd_qz - vrData.hmd_qy) * r_sqrt2_inv;
-            
-            // Normalize quaternion
-            float mag = sqrtf(game_qw*game_qw + game_qx*game_qx + game_qy*game_qy + game_qz*game_qz);
-            if (mag > 0.0f) {
-                float invMag = 1.0f / mag;
-                game_qw *= invMag;
-                game_qx *= invMag;
-                game_qy *= invMag;
-                game_qz *= invMag;
+                return false;
             }
-            
-            // Convert quaternion to rotation matrix for NiTransform
-            // Using standard quaternion to matrix conversion
-            float xx = game_qx * game_qx;
-            float yy = game_qy * game_qy;
-            float zz = game_qz * game_qz;
-            float xy = game_qx * game_qy;
-            float xz = game_qx * game_qz;
-            float yz = game_qy * game_qz;
-            float wx = game_qw * game_qx;
-            float wy = game_qw * game_qy;
-            float wz = game_qw * game_qz;
-            
-            headBone->m_localTransform.rot.data[0][0] = 1.0f - 2.0f * (yy + zz);
-            headBone->m_localTransform.rot.data[0][1] = 2.0f * (xy - wz);
-            headBone->m_localTransform.rot.data[0][2] = 2.0f * (xz + wy);
-            
-            headBone->m_localTransform.rot.data[1][0] = 2.0f * (xy + wz);
-            headBone->m_localTransform.rot.data[1][1] = 1.0f - 2.0f * (xx + zz);
-            headBone->m_localTransform.rot.data[1][2] = 2.0f * (yz - wx);
-            
-            headBone->m_localTransform.rot.data[2][0] = 2.0f * (xz - wy);
-            headBone->m_localTransform.rot.data[2][1] = 2.0f * (yz + wx);
-            headBone->m_localTransform.rot.data[2][2] = 1.0f - 2.0f * (xx + yy);
+            SetBoneFromPose(headBone, poses, FNVR::kPose_Hmd, g_positionOffsetX, g_positionOffsetY, g_positionOffsetZ);
             
             // Update transforms
-            headBone->Update(0.0f);
+            {
+                FNVR_PROFILE_SCOPE(FNVR::kStage_HeadUpdate);
+                headBone->Update(0.0f);
+            }
+            latch.head = headBone;
         }
     }
     
     // Apply hand tracking with safety checks
     if (g_enableHandTracking) {
         // Right hand with comprehensive validation
-        NiNode* rightHand = FindBone(skeletonRoot, "Bip01 R Hand");
+        NiNode* rightHand;
+        {
+            FNVR_PROFILE_SCOPE(FNVR::kStage_BoneLookup);
+            rightHand = GetCachedBone(cache, FNVR::NVCSSkeleton::NVCS_BIP01_R_HAND);
+        }
         if (!rightHand) {
             Log("Warning: Could not find Bip01 R Hand bone");
         } else {
             // Validate bone before manipulation
             if (!rightHand->m_parent) {
                 Log("Warning: Right hand bone has no parent, skipping");
-                return;
+                return false;
             }
-            // Convert VR controller coordinates to game coordinates
-            // Same transformation as HMD
-            float gameX =  vrData.right_px * g_positionScale;  // X -> X
-            float gameY = -vrData.right_pz * g_positionScale;  // -Z -> Y
-            float gameZ =  vrData.right_py * g_positionScale;  // Y -> Z
+            // Same transformation as HMD, with the hand offsets
+            SetBoneFromPose(rightHand, poses, FNVR::kPose_Right, g_handOffsetX, g_handOffsetY, g_handOffsetZ);
             
-            // Apply position with offsets
-            rightHand->m_localTransform.pos.x = gameX + g_handOffsetX;
-            rightHand->m_localTransform.pos.y = gameY + g_handOffsetY;
-            rightHand->m_localTransform.pos.z = gameZ + g_handOffsetZ;
-            
-            // Quaternion conversion for rotation
-            const float r_sqrt2_inv = 0.7071067811865476f;
-            
-            float game_qw = (vrData.right_qw + vrData.right_qx) * r_sqrt2_inv;
-            float game_qx = (vrData.right_qx - vrData.right_qw) * r_sqrt2_inv;
-            float game_qy = (vrData.right_qy + vrData.right_qz) * r_sqrt2_inv;
-            float game_qz = (vrData.right_qz - vrData.right_qy) * r_sqrt2_inv;
-            
-            // Normalize
-            float mag = sqrtf(game_qw*game_qw + game_qx*game_qx + game_qy*game_qy + game_qz*game_qz);
-            if (mag > 0.0f) {
-                float invMag = 1.0f / mag;
-                game_qw *= invMag;
-                game_qx *= invMag;
-                game_qy *= invMag;
-                game_qz *= invMag;
+            {
+                FNVR_PROFILE_SCOPE(FNVR::kStage_HandUpdate);
+                rightHand->Update(0.0f);
             }
-            
-            // Convert quaternion to rotation matrix
-            float xx = game_qx * game_qx;
-            float yy = game_qy * game_qy;
-            float zz = game_qz * game_qz;
-            float xy = game_qx * game_qy;
-            float xz = game_qx * game_qz;
-            float yz = game_qy * game_qz;
-            float wx = game_qw * game_qx;
-            float wy = game_qw * game_qy;
-            float wz = game_qw * game_qz;
-            
-            rightHand->m_localTransform.rot.data[0][0] = 1.0f - 2.0f * (yy + zz);
-            rightHand->m_localTransform.rot.data[0][1] = 2.0f * (xy - wz);
-            rightHand->m_localTransform.rot.data[0][2] = 2.0f * (xz + wy);
-            
-            rightHand->m_localTransform.rot.data[1][0] = 2.0f * (xy + wz);
-            rightHand->m_localTransform.rot.data[1][1] = 1.0f - 2.0f * (xx + zz);
-            rightHand->m_localTransform.rot.data[1][2] = 2.0f * (yz - wx);
-            
-            rightHand->m_localTransform.rot.data[2][0] = 2.0f * (xz - wy);
-            rightHand->m_localTransform.rot.data[2][1] = 2.0f * (yz + wx);
-            rightHand->m_localTransform.rot.data[2][2] = 1.0f - 2.0f * (xx + yy);
-            
-            rightHand->Update(0.0f);
+            latch.rightHand = rightHand;
         }
         
         // Update weapon node with safety check
-        NiNode* weaponNode = FindBone(skeletonRoot, "Weapon");
+        NiNode* weaponNode;
+        {
+            FNVR_PROFILE_SCOPE(FNVR::kStage_BoneLookup);
+            weaponNode = GetCachedBone(cache, FNVR::NVCSSkeleton::NVCS_WEAPON);
+        }
         if (weaponNode && weaponNode->m_parent) {
-            weaponNode->Update(0.0f);
+            {
+                FNVR_PROFILE_SCOPE(FNVR::kStage_WeaponUpdate);
+                weaponNode->Update(0.0f);
+            }
+            latch.weapon = weaponNode;
         } else if (weaponNode) {
             Log("Warning: Weapon node exists but has no parent");
         }
     }
+    return true;
+}
+
+// Apply VR data to skeleton with comprehensive safety checks
+void ApplyVRDataToSkeleton() {
+    // === STAGE 1: Game State Validation ===
+    if (!IsGameStateValid()) {
+        return; // Not safe to update
+    }
+    
+    // === STAGE 2-3: Player Validation, Skeleton Roots ===
+    NiNode* roots[kView_Count];
+    SkeletonView shownView;
+    TESObjectCELL* cell;
+    if (!GetPlayerSkeletonRoots(roots, shownView, cell)) {
+        return;
+    }
+    
+    // Ensure both bone caches are valid, the hidden view's too, so a view switch
+    // finds its table ready instead of rebuilding it in the frame of the switch
+    bool cacheReady[kView_Count];
+    for (int view = 0; view < kView_Count; view++) {
+        cacheReady[view] = RefreshBoneCache((SkeletonView)view, roots[view], cell);
+    }
+    if (!cacheReady[shownView]) {
+        return;
+    }
+    
+    // === STAGE 4: Acquire Latest VR Data (wait-free) ===
+    // With the jitter buffer or prediction the pose moves every frame, new packet or
+    // not; with the late latch the newest packet may already have been taken by last
+    // frame's latch
+    const bool reapply = PosesChangeBetweenPackets() || g_lateLatchHookTarget != 0;
+    if (!g_poseMailbox.Acquire() && !(reapply && g_isPipeConnected)) {
+        static int noDataCount = 0;
+        if (++noDataCount % 600 == 0) { // Log every 10 seconds
+            Log("Warning: No new VR data available (pipe connected: %s)", 
+                g_isPipeConnected ? "yes" : "no");
+        }
+        return;
+    }
+    
+    // Newest complete packet, read in place; owned by this thread until the next Acquire()
+    const VRPacketView vrData(g_poseMailbox.Front());
+    if (!vrData.IsValid()) {
+        return; // Nothing received yet
+    }
+    
+    FNVR::PoseSample poses;
+    SelectPoses(vrData, poses);
+    const VRPose& hmd = poses.poses[FNVR::kPose_Hmd];
+    
+    // Debug: Log data reception occasionally
+    static int dataFrameCount = 0;
+    if (++dataFrameCount % 300 == 0) { // Every 5 seconds at 60fps
+        Log("VR data received: HMD pos(%.2f,%.2f,%.2f) rot(%.2f,%.2f,%.2f,%.2f)",
+            hmd.px, hmd.py, hmd.pz,
+            hmd.qw, hmd.qx, hmd.qy, hmd.qz);
+    }
+    
+    // Converted once; both skeletons are posed from the same results
+    FNVR::ConvertedPoseBatch converted;
+    ConvertSelectedPoses(poses, converted);
+    
+    LateLatchTargets latch = {};
+    if (!PoseSkeleton(g_boneCaches[shownView], converted, latch)) {
+        return;
+    }
+    
+    // Mods that show the first-person body and the third-person shadow at once need
+    // both posed; the hidden one keeps the start-of-frame pose (not late-latched)
+    const SkeletonView hiddenView = shownView == kView_FirstPerson ? kView_ThirdPerson : kView_FirstPerson;
+    if (g_poseBothSkeletons && cacheReady[hiddenView]) {
+        LateLatchTargets unused = {};
+        PoseSkeleton(g_boneCaches[hiddenView], converted, unused);
+    }
+    
+    // Bones are written: this is the "applied" end of motion-to-apply latency
+    // (measured from the time the applied pose represents, so buffering is included)
+    const bool monotonic = vrData.HasMonotonicTimestamp();
+    if (g_measureLatency) {
+        double now = FNVR::ClockSync::Now(monotonic);
+        g_applyLatency.Record(g_clockSync.GetLatency(poses.timestamp, now));
+    }
+    
+    // Hand the validated bones to the late latch for this frame
+    latch.monotonic = monotonic;
+    latch.pending = latch.head || latch.rightHand;
+    g_latchTargets = latch;
     
     // Update global variables
-    FNVR::Globals::UpdateGlobals(vrData);
+    {
+        FNVR_PROFILE_SCOPE(FNVR::kStage_UpdateGlobals);
+        FNVR::Globals::UpdateGlobals(vrData);
+    }
+}
+
+// One apply pass, timed; shared by both apply modes
+void RunApplyStep() {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    // Bones from an earlier frame may be gone by now (cell change, 1st/3rd person switch)
+    g_latchTargets.pending = false;
+    ApplyVRDataToSkeleton();
+    
+    if (g_latchTargets.pending && g_lateLatchHookTarget) {
+        // Fallback notice: the hook exists but the render call never reaches it
+        // (another plugin re-patched the call site after us)
+        if (++g_appliedFrames == 600 && g_latchedFrames == 0) {
+            Log("Late latch: render hook not firing, using poses from the start of the frame");
+        }
+    }
+    
+    // Fix first person body visibility
+    {
+        FNVR_PROFILE_SCOPE(FNVR::kStage_BodyFix);
+        FNVR::FirstPersonBodyFix::Update();
+    }
+    
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+    g_applyCost.Record(duration * 1e-6);
+    
+    // Profiling: Log duration if in debug mode
+    if (g_enableLogging && duration > 5000) {  // Warn if >5ms
+        Log("Update took %ld us", (long)duration);
+    }
 }
 
-// Update thread (60 FPS)
+// Late latch (main thread, right before the game-mode render pass): re-pose the bones
+// this frame's apply wrote, from the newest tracker data
+void LateLatchPoses() {
+    if (!g_latchTargets.pending) {
+        return;
+    }
+    FNVR_PROFILE_SCOPE(FNVR::kStage_LateLatch);
+    g_latchTargets.pending = false;
+    
+    // May take a packet the next apply would have seen; the apply re-reads Front() then
+    g_poseMailbox.Acquire();
+    const VRPacketView vrData(g_poseMailbox.Front());
+    if (!vrData.IsValid() || vrData.HasMonotonicTimestamp() != g_latchTargets.monotonic) {
+        return;
+    }
+    
+    FNVR::PoseSample poses;
+    SelectPoses(vrData, poses);
+    FNVR::ConvertedPoseBatch converted;
+    ConvertSelectedPoses(poses, converted);
+    
+    // Only the tracked bones' local transforms; Update() refreshes their world transforms
+    if (g_latchTargets.head) {
+        SetBoneFromPose(g_latchTargets.head, converted, FNVR::kPose_Hmd,
+            g_positionOffsetX, g_positionOffsetY, g_positionOffsetZ);
+        g_latchTargets.head->Update(0.0f);
+    }
+    if (g_latchTargets.rightHand) {
+        SetBoneFromPose(g_latchTargets.rightHand, converted, FNVR::kPose_Right,
+            g_handOffsetX, g_handOffsetY, g_handOffsetZ);
+        g_latchTargets.rightHand->Update(0.0f);
+        if (g_latchTargets.weapon) {
+            g_latchTargets.weapon->Update(0.0f);
+        }
+    }
+    g_latchedFrames++;
+    
+    if (g_measureLatency) {
+        double now = FNVR::ClockSync::Now(g_latchTargets.monotonic);
+        g_latchLatency.Record(g_clockSync.GetLatency(poses.timestamp, now));
+    }
+}
+
+// Stands in for the main loop's call to the game-mode render function
+// (thiscall, three arguments); latches, then continues to the chained target
+UInt32 __fastcall LateLatchRenderHook(void* renderer, void* edx, int arg1, int arg2, int arg3) {
+    LateLatchPoses();
+    return ((UInt32(__thiscall*)(void*, int, int, int))g_lateLatchHookTarget)(renderer, arg1, arg2, arg3);
+}
+
+// Redirect the rel32 call at callSite to hook. Returns the previous call target
+// (which the hook must call on), or 0 if callSite does not hold a call.
+UInt32 InstallCallHook(UInt32 callSite, void* hook) {
+    UInt8 opcode = 0;
+    SInt32 relative = 0;
+    if (!SafeRead(callSite, opcode) || opcode != 0xE8 || !SafeRead(callSite + 1, relative)) {
+        return 0;
+    }
+    UInt32 previous = callSite + 5 + relative;
+    
+    DWORD oldProtect;
+    if (!VirtualProtect((void*)callSite, 5, PAGE_EXECUTE_READWRITE, &oldProtect)) {
+        return 0;
+    }
+    *reinterpret_cast<SInt32*>(callSite + 1) = (SInt32)((UInt32)hook - callSite - 5);
+    VirtualProtect((void*)callSite, 5, oldProtect, &oldProtect);
+    FlushInstructionCache(GetCurrentProcess(), (void*)callSite, 5);
+    return previous;
+}
+
+// Update thread (game frame rate)
 void UpdateThreadFunc() {
     Log("Update thread started");
     
+    double nextUpdate = FNVR::ClockSync::MonotonicNow();
     while (!g_shouldStop) {
-        auto startTime = std::chrono::high_resolution_clock::now();
-        
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - g_lastUpdateTime).count();
+        // Sleep to the next frame deadline (no polling)
+        if (g_updateScheduler.Wait(nextUpdate, false) == FNVR::WakeScheduler::kWake_Stop) {
+            break;
+        }
         
-        if (elapsed >= UPDATE_INTERVAL_MS) {
-            // VorpX mode check
-            if (g_vorpxMode) {
-                // Sync with assumed VorpX frame rate (e.g., 90 Hz)
-                const int VORPX_INTERVAL_MS = 11;  // ~90 Hz
-                if (elapsed < VORPX_INTERVAL_MS) continue;  // Skip if not time
-                
-                // Use cached VorpX head data (from memory scan in NVCSSkeleton)
-                // Assume updated elsewhere; for PoC, simulate
-                g_cachedVorpxHeadPos.v[0] += 0.1f;  // Dummy update
+        // Nothing would change without a new packet: sleep on until one arrives, but
+        // still re-apply every few frames so animation can't keep the bones
+        const double frameInterval = g_framePacer.GetFrameInterval();
+        g_updateScheduler.ResetNewData();
+        if (!g_poseMailbox.HasNew() && !PosesChangeBetweenPackets()) {
+            if (g_updateScheduler.Wait(nextUpdate + MAX_IDLE_FRAMES * frameInterval, true) == FNVR::WakeScheduler::kWake_Stop) {
+                break;
             }
-            
-            ApplyVRDataToSkeleton();
-            
-            // Fix first person body visibility
-            FNVR::FirstPersonBodyFix::Update();
-            
-            g_lastUpdateTime = now;
         }
         
-        // Profiling: Log duration if in debug mode
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
-        if (g_enableLogging && duration > 5000) {  // Warn if >5ms
-            Log("Update took %ld us", duration);
+        // VorpX mode check
+        if (g_vorpxMode) {
+            // Use cached VorpX head data (from memory scan in NVCSSkeleton)
+            // Assume updated elsewhere; for PoC, simulate
+            g_cachedVorpxHeadPos.v[0] += 0.1f;  // Dummy update
         }
         
-        Sleep(1);
+        // One update per measured game frame (covers VorpX's frame rate as well)
+        nextUpdate = FNVR::ClockSync::MonotonicNow() + frameInterval;
+        RunApplyStep();
     }
     
     Log("Update thread stopped");
 }
 
+// Console command: FNVRLatency [reset]
+// Prints this session's motion-to-apply latency percentiles; 1 clears them afterwards.
+// Returns p99 in milliseconds.
+bool Cmd_FNVRLatency_Execute(COMMAND_ARGS) {
+    *result = 0;
+    UInt32 reset = 0;
+    if (g_script && !g_script->ExtractArgsEx(EXTRACT_ARGS_EX, &reset)) {
+        return true;
+    }
+    
+    if (!g_measureLatency) {
+        Console_Print("FNVR latency: not measured for replayed sessions");
+        return true;
+    }
+    
+    char summary[256];
+    g_applyLatency.FormatSummary(summary, sizeof(summary));
+    Console_Print("FNVR latency (packet -> bones): %s", summary);
+    if (g_lateLatchHookTarget) {
+        g_latchLatency.FormatSummary(summary, sizeof(summary));
+        Console_Print("FNVR late-latched pose age: %s", summary);
+    }
+    Console_Print("FNVR transport floor %.2fms, tracker %s", g_clockSync.GetTransportFloor() * 1e3,
+        g_isPipeConnected ? "connected" : "disconnected");
+    Console_Print("FNVR jitter buffer: depth %u, adds %.1fms", g_jitterBuffer.GetDepth(), g_jitterBuffer.GetPlayoutDelay() * 1e3);
+    g_applyCost.FormatSummary(summary, sizeof(summary));
+    Console_Print("FNVR apply cost per %s: %s", g_applyMode == kApply_FrameSync ? "frame" : "update", summary);
+    g_boneCacheCost.FormatSummary(summary, sizeof(summary));
+    Console_Print("FNVR bone cache: %u rebuilds, cost %s", g_boneCacheRebuilds, summary);
+    if (g_applyMode == kApply_UpdateThread) {
+        Console_Print("FNVR update thread: %.1f wakeups/s", g_updateScheduler.GetWakeupsPerSecond());
+    }
+    Console_Print("FNVR frame pacing: %.2fms (%.0f fps), %u outliers ignored, prediction %.1fms",
+        g_framePacer.GetFrameInterval() * 1e3, g_framePacer.GetFrameRate(), g_framePacer.GetRejectedCount(),
+        GetPredictionHorizon() * 1e3);
+    *result = g_applyLatency.GetPercentile(0.99) * 1e3;
+    
+    if (reset) {
+        g_applyLatency.RequestReset();
+        g_applyCost.RequestReset();
+        g_latchLatency.RequestReset();
+        g_boneCacheCost.RequestReset();
+    }
+    return true;
+}
+
+DEFINE_COMMAND_PLUGIN(FNVRLatency, "Prints FNVR motion-to-apply latency percentiles", false, kParams_OneOptionalInt)
+
+// Console command: FNVRProfile [reset]
+// Prints p50/p99/max per apply pipeline stage (profiling builds only); 1 clears them afterwards.
+bool Cmd_FNVRProfile_Execute(COMMAND_ARGS) {
+    *result = 0;
+    UInt32 reset = 0;
+    if (g_script && !g_script->ExtractArgsEx(EXTRACT_ARGS_EX, &reset)) {
+        return true;
+    }
+    
+#ifdef FNVR_ENABLE_PROFILER
+    for (int stage = 0; stage < FNVR::kStage_Count; stage++) {
+        char line[128];
+        FNVR::FrameProfiler::FormatStage((FNVR::ProfileStage)stage, line, sizeof(line));
+        Console_Print("FNVR %s", line);
+    }
+    if (reset) {
+        FNVR::FrameProfiler::RequestReset();
+    }
+#else
+    Console_Print("FNVR profiler not compiled in (build with -DFNVR_PROFILER=ON)");
+#endif
+    return true;
+}
+
+DEFINE_COMMAND_PLUGIN(FNVRProfile, "Prints FNVR apply pipeline stage timings", false, kParams_OneOptionalInt)
+
 // Message handler
 void MessageHandler(NVSEMessagingInterface::Message* msg) {
     switch (msg->type) {
@@ -617,13 +1103,18 @@ void MessageHandler(NVSEMessagingInterface::Message* msg) {
             break;
             
         case NVSEMessagingInterface::kMessage_MainGameLoop:
-            // Alternative to thread-based updates
-            // ApplyVRDataToSkeleton();
+            g_framePacer.Tick(FNVR::ClockSync::MonotonicNow());
+            
+            // Frame-locked apply: main thread, once at the top of each frame,
+            // so poses are never torn mid-frame or written at a random phase
+            if (g_applyMode == kApply_FrameSync && !g_shouldStop) {
+                RunApplyStep();
+            }
             break;
             
         case NVSEMessagingInterface::kMessage_ExitGame:
             Log("Game exiting");
-            g_shouldStop = true;
+            RequestStop();
             break;
     }
 }
@@ -677,8 +1168,10 @@ bool NVSEPlugin_Load(const NVSEInterface* nvse) {
     // Register message handler
     g_messaging->RegisterListener(nvse->GetPluginHandle(), "NVSE", MessageHandler);
     
-    // Initialize critical section
-    InitializeCriticalSection(&g_dataLock);
+    // Console commands (development opcode range; needs an assigned base before public release)
+    nvse->SetOpcodeBase(FNVR_OPCODE_BASE);
+    nvse->RegisterCommand(&kCommandInfo_FNVRLatency);
+    nvse->RegisterCommand(&kCommandInfo_FNVRProfile);  // Registered in every build so opcodes don't shift
     
     // Initialize modules
     FNVR::VRSystem::Initialize();
@@ -686,8 +1179,29 @@ bool NVSEPlugin_Load(const NVSEInterface* nvse) {
     
     // Start threads
     g_shouldStop = false;
+    g_stopEvent = CreateEventA(NULL, TRUE, FALSE, NULL);
     g_pipeThread = new std::thread(PipeThreadFunc);
-    g_updateThread = new std::thread(UpdateThreadFunc);
+    if (g_applyMode == kApply_UpdateThread && !g_updateScheduler.Create()) {
+        Log("ERROR: Couldn't create update thread timer, applying per frame instead");
+        g_applyMode = kApply_FrameSync;
+    }
+    if (g_applyMode == kApply_UpdateThread) {
+        g_updateThread = new std::thread(UpdateThreadFunc);
+    }
+    
+    // Late latch needs the apply on the main thread; the render call is made there too
+    if (!nvse->isEditor && g_lateLatchEnabled) {
+        if (g_applyMode != kApply_FrameSync) {
+            Log("Late latch requires ApplyMode = 1, disabled");
+        } else {
+            g_lateLatchHookTarget = InstallCallHook(kLateLatchCallSite, (void*)LateLatchRenderHook);
+            if (g_lateLatchHookTarget) {
+                Log("Late latch hooked at %08X (chained to %08X)", kLateLatchCallSite, g_lateLatchHookTarget);
+            } else {
+                Log("Late latch: unexpected code at %08X, using frame-start poses", kLateLatchCallSite);
+            }
+        }
+    }
     
     Log("FNVR Plugin loaded successfully");
     return true;
@@ -697,8 +1211,8 @@ bool NVSEPlugin_Load(const NVSEInterface* nvse) {
 extern "C" {
     BOOL WINAPI DllMain(HANDLE hDllHandle, DWORD dwReason, LPVOID lpreserved) {
         if (dwReason == DLL_PROCESS_DETACH) {
-            // Cleanup
-            g_shouldStop = true;
+            // Cleanup: the stop event aborts pending pipe reads, so join() returns promptly
+            RequestStop();
             
             if (g_pipeThread) {
                 g_pipeThread->join();
@@ -710,7 +1224,10 @@ extern "C" {
                 delete g_updateThread;
             }
             
-            DeleteCriticalSection(&g_dataLock);
+            if (g_stopEvent) {
+                CloseHandle(g_stopEvent);
+                g_stopEvent = NULL;
+            }
         }
         return TRUE;
     }
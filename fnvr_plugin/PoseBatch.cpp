@@ -0,0 +1,108 @@
+// fnvr_plugin/PoseBatch.cpp
+#include "PoseBatch.h"
+#include "CoordinateFrames.h"
+#include <emmintrin.h>
+
+namespace FNVR {
+
+// The rotation below is OpenVRToGamebryoQuat() * q written out for its constant
+static_assert(FrameDetail::Near(GamebryoAxesToOpenVR::Q(0), 0.70710678f) && FrameDetail::Near(GamebryoAxesToOpenVR::Q(1), -0.70710678f)
+           && GamebryoAxesToOpenVR::Q(2) == 0.0f && GamebryoAxesToOpenVR::Q(3) == 0.0f,
+    "ConvertPoseBatch expands the bone rotation quaternion by hand");
+
+void LoadPoseBatch(const PoseSample& sample, PoseBatch& out)
+{
+    for (int lane = 0; lane < kPoseBatchLanes; lane += 4) {
+        // Each device's (w, x, y, z) is one unaligned load; a 4x4 transpose turns the
+        // four devices into the qw/qx/qy/qz rows
+        __m128 q[4];
+        float p[3][4];
+        for (int i = 0; i < 4; i++) {
+            int device = lane + i;
+            if (device < kPose_Count) {
+                const VRPose& pose = sample.poses[device];
+                q[i] = _mm_loadu_ps(&pose.qw);
+                p[0][i] = pose.px;
+                p[1][i] = pose.py;
+                p[2][i] = pose.pz;
+            } else {
+                q[i] = _mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f);  // Identity at the origin
+                p[0][i] = p[1][i] = p[2][i] = 0.0f;
+            }
+        }
+        _MM_TRANSPOSE4_PS(q[0], q[1], q[2], q[3]);
+        _mm_storeu_ps(out.qw + lane, q[0]);
+        _mm_storeu_ps(out.qx + lane, q[1]);
+        _mm_storeu_ps(out.qy + lane, q[2]);
+        _mm_storeu_ps(out.qz + lane, q[3]);
+        _mm_storeu_ps(out.px + lane, _mm_loadu_ps(p[0]));
+        _mm_storeu_ps(out.py + lane, _mm_loadu_ps(p[1]));
+        _mm_storeu_ps(out.pz + lane, _mm_loadu_ps(p[2]));
+    }
+}
+
+void ConvertPoseBatch(const PoseBatch& in, float scale, ConvertedPoseBatch& out)
+{
+    typedef OpenVRToGamebryoAxes Axes;
+    const __m128 factor[3] = {
+        _mm_set1_ps(Axes::Factor(0) * scale),
+        _mm_set1_ps(Axes::Factor(1) * scale),
+        _mm_set1_ps(Axes::Factor(2) * scale)
+    };
+    const __m128 halfSqrt2 = _mm_set1_ps(0.7071067811865476f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+
+    for (int lane = 0; lane < kPoseBatchLanes; lane += 4) {
+        // Position: the frames' axis permutation, sign and scale folded into one factor
+        const float* source[3] = {in.px + lane, in.py + lane, in.pz + lane};
+        _mm_storeu_ps(out.px + lane, _mm_mul_ps(_mm_loadu_ps(source[Axes::Source(0)]), factor[0]));
+        _mm_storeu_ps(out.py + lane, _mm_mul_ps(_mm_loadu_ps(source[Axes::Source(1)]), factor[1]));
+        _mm_storeu_ps(out.pz + lane, _mm_mul_ps(_mm_loadu_ps(source[Axes::Source(2)]), factor[2]));
+
+        // (cos 45, -sin 45, 0, 0) * q, expanded: the -90 degree X pre-rotation
+        __m128 qw = _mm_loadu_ps(in.qw + lane);
+        __m128 qx = _mm_loadu_ps(in.qx + lane);
+        __m128 qy = _mm_loadu_ps(in.qy + lane);
+        __m128 qz = _mm_loadu_ps(in.qz + lane);
+        __m128 w = _mm_mul_ps(_mm_add_ps(qw, qx), halfSqrt2);
+        __m128 x = _mm_mul_ps(_mm_sub_ps(qx, qw), halfSqrt2);
+        __m128 y = _mm_mul_ps(_mm_add_ps(qy, qz), halfSqrt2);
+        __m128 z = _mm_mul_ps(_mm_sub_ps(qz, qy), halfSqrt2);
+
+        // Normalize: the constant is unit, this is for interpolated and extrapolated
+        // input. Full-precision sqrt and divide as in QuatNormalize.
+        __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w, w), _mm_mul_ps(x, x)),
+                                     _mm_add_ps(_mm_mul_ps(y, y), _mm_mul_ps(z, z)));
+        __m128 nonZero = _mm_cmpgt_ps(lengthSq, _mm_setzero_ps());
+        __m128 inverse = _mm_and_ps(nonZero, _mm_div_ps(one, _mm_sqrt_ps(lengthSq)));
+        inverse = _mm_or_ps(inverse, _mm_andnot_ps(nonZero, one));
+        w = _mm_mul_ps(w, inverse);
+        x = _mm_mul_ps(x, inverse);
+        y = _mm_mul_ps(y, inverse);
+        z = _mm_mul_ps(z, inverse);
+        _mm_storeu_ps(out.qw + lane, w);
+        _mm_storeu_ps(out.qx + lane, x);
+        _mm_storeu_ps(out.qy + lane, y);
+        _mm_storeu_ps(out.qz + lane, z);
+
+        // Rotation matrix (column vectors, as QuatToRows)
+        __m128 x2 = _mm_mul_ps(x, two);
+        __m128 y2 = _mm_mul_ps(y, two);
+        __m128 z2 = _mm_mul_ps(z, two);
+        __m128 xx = _mm_mul_ps(x, x2), yy = _mm_mul_ps(y, y2), zz = _mm_mul_ps(z, z2);
+        __m128 xy = _mm_mul_ps(x, y2), xz = _mm_mul_ps(x, z2), yz = _mm_mul_ps(y, z2);
+        __m128 wx = _mm_mul_ps(w, x2), wy = _mm_mul_ps(w, y2), wz = _mm_mul_ps(w, z2);
+        _mm_storeu_ps(out.m[0] + lane, _mm_sub_ps(one, _mm_add_ps(yy, zz)));
+        _mm_storeu_ps(out.m[1] + lane, _mm_sub_ps(xy, wz));
+        _mm_storeu_ps(out.m[2] + lane, _mm_add_ps(xz, wy));
+        _mm_storeu_ps(out.m[3] + lane, _mm_add_ps(xy, wz));
+        _mm_storeu_ps(out.m[4] + lane, _mm_sub_ps(one, _mm_add_ps(xx, zz)));
+        _mm_storeu_ps(out.m[5] + lane, _mm_sub_ps(yz, wx));
+        _mm_storeu_ps(out.m[6] + lane, _mm_sub_ps(xz, wy));
+        _mm_storeu_ps(out.m[7] + lane, _mm_add_ps(yz, wx));
+        _mm_storeu_ps(out.m[8] + lane, _mm_sub_ps(one, _mm_add_ps(xx, yy)));
+    }
+}
+
+} // namespace FNVR
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "PoseJitterBuffer.h"
+
+// All tracked devices of a frame converted OpenVR -> Gamebryo in one pass.
+//
+// The poses are held structure-of-arrays: lane i of every array is device i
+// (PoseDevice order), so each SSE instruction works on four devices at once - the
+// axis swap and scale, the -90 degree X pre-rotation, the normalize and all nine
+// matrix terms. The apply path converts once per pose selection and every bone
+// written from that selection (shown and hidden skeleton, late latch) reads the
+// results instead of converting again.
+//
+// A new device (tracker) only needs a PoseDevice entry; the lane count rounds up to
+// whole registers.
+
+namespace FNVR {
+
+static const int kPoseBatchLanes = (kPose_Count + 3) & ~3;
+
+// Tracker space: right-handed, Y up, -Z forward, meters
+struct PoseBatch {
+    float qw[kPoseBatchLanes], qx[kPoseBatchLanes], qy[kPoseBatchLanes], qz[kPoseBatchLanes];
+    float px[kPoseBatchLanes], py[kPoseBatchLanes], pz[kPoseBatchLanes];
+};
+
+// Game space: Z up, Y forward, scaled to game units. Unused lanes hold the converted
+// identity pose (the pre-rotation at the origin); nothing reads them.
+struct ConvertedPoseBatch {
+    float px[kPoseBatchLanes], py[kPoseBatchLanes], pz[kPoseBatchLanes];
+    float qw[kPoseBatchLanes], qx[kPoseBatchLanes], qy[kPoseBatchLanes], qz[kPoseBatchLanes];  // Unit
+    float m[9][kPoseBatchLanes];  // Rotation, row-major: m[row * 3 + column][device]
+
+    // Rotation of one device into a row-major float[3][3] (NiMatrix33)
+    void GetRotation(int device, float* out) const
+    {
+        for (int i = 0; i < 9; i++) {
+            out[i] = m[i][device];
+        }
+    }
+};
+
+// AoS -> SoA; lanes past kPose_Count are filled with the identity pose
+void LoadPoseBatch(const PoseSample& sample, PoseBatch& out);
+
+// Position: OpenVRToGamebryoAxes (x, y, z) -> (x, -z, y), times scale. Rotation:
+// OpenVRToGamebryoQuat() * q, normalized (a zero quaternion stays zero), then expanded
+// to a matrix. Per device the same results as the single-pose kernels.
+void ConvertPoseBatch(const PoseBatch& in, float scale, ConvertedPoseBatch& out);
+
+} // namespace FNVR
@@ -0,0 +1,192 @@
+// fnvr_plugin/PoseJitterBuffer.cpp
+#include "PoseJitterBuffer.h"
+#include <cmath>
+
+namespace FNVR {
+
+const double PoseJitterBuffer::kDiscontinuitySeconds = 0.5;
+const double PoseJitterBuffer::kMaxIntervalSeconds = 0.1;
+
+void InterpolatePose(const VRPose& a, const VRPose& b, float t, VRPose& out)
+{
+    out.px = a.px + (b.px - a.px) * t;
+    out.py = a.py + (b.py - a.py) * t;
+    out.pz = a.pz + (b.pz - a.pz) * t;
+
+    // q and -q are the same rotation: flip b onto a's hemisphere for the short arc
+    float dot = a.qw * b.qw + a.qx * b.qx + a.qy * b.qy + a.qz * b.qz;
+    float sign = 1.0f;
+    if (dot < 0.0f) {
+        dot = -dot;
+        sign = -1.0f;
+    }
+
+    float wa, wb;
+    if (dot > 0.9995f) {
+        // Nearly identical: slerp degenerates, a normalized lerp is exact enough
+        wa = 1.0f - t;
+        wb = t;
+    } else {
+        float theta = acosf(dot);
+        float invSin = 1.0f / sinf(theta);
+        wa = sinf((1.0f - t) * theta) * invSin;
+        wb = sinf(t * theta) * invSin;
+    }
+    wb *= sign;
+
+    out.qw = wa * a.qw + wb * b.qw;
+    out.qx = wa * a.qx + wb * b.qx;
+    out.qy = wa * a.qy + wb * b.qy;
+    out.qz = wa * a.qz + wb * b.qz;
+
+    float mag = sqrtf(out.qw * out.qw + out.qx * out.qx + out.qy * out.qy + out.qz * out.qz);
+    if (mag > 0.0f) {
+        float invMag = 1.0f / mag;
+        out.qw *= invMag;
+        out.qx *= invMag;
+        out.qy *= invMag;
+        out.qz *= invMag;
+    }
+}
+
+PoseJitterBuffer::PoseJitterBuffer()
+    : m_writeSequence(0), m_firstSequence(1), m_intervalUs(kNominalIntervalUs), m_depth(0), m_outOfOrder(0),
+      m_newestTimestamp(0.0), m_interval(kNominalIntervalUs * 1e-6)
+{
+    for (uint32_t i = 0; i < kCapacity; i++) {
+        m_slots[i].sequence.store(0, std::memory_order_relaxed);
+    }
+}
+
+void PoseJitterBuffer::SetDepth(uint32_t depth)
+{
+    m_depth.store(depth > kMaxDepth ? kMaxDepth : depth, std::memory_order_relaxed);
+}
+
+void PoseJitterBuffer::Reset()
+{
+    // Samples numbered below firstSequence are no longer part of the history
+    m_firstSequence.store(m_writeSequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    m_interval = kNominalIntervalUs * 1e-6;
+    m_intervalUs.store(kNominalIntervalUs, std::memory_order_relaxed);
+}
+
+bool PoseJitterBuffer::Push(const VRPacketView& packet)
+{
+    const double timestamp = packet.GetTimestamp();
+    uint32_t n = m_writeSequence.load(std::memory_order_relaxed);
+    uint32_t first = m_firstSequence.load(std::memory_order_relaxed);
+
+    if (n + 1 != first) {
+        double delta = timestamp - m_newestTimestamp;
+        if (delta <= 0.0 && delta > -kDiscontinuitySeconds) {
+            m_outOfOrder.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (delta <= 0.0) {
+            Reset();
+        } else if (delta < kMaxIntervalSeconds) {
+            // Smoothed over ~16 samples: follows rate changes, ignores single late sends
+            m_interval += (delta - m_interval) * (1.0 / 16.0);
+            m_intervalUs.store((uint32_t)(m_interval * 1e6), std::memory_order_relaxed);
+        }
+    }
+
+    n++;
+    Slot& slot = m_slots[n % kCapacity];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.sample.timestamp = timestamp;
+    slot.sample.poses[kPose_Hmd] = packet.Hmd();
+    slot.sample.poses[kPose_Right] = packet.Right();
+    slot.sample.poses[kPose_Left] = packet.Left();
+    slot.sequence.store(n, std::memory_order_release);
+    m_writeSequence.store(n, std::memory_order_release);
+
+    m_newestTimestamp = timestamp;
+    return true;
+}
+
+bool PoseJitterBuffer::ReadSlot(uint32_t sequence, PoseSample& out) const
+{
+    const Slot& slot = m_slots[sequence % kCapacity];
+    if (slot.sequence.load(std::memory_order_acquire) != sequence) {
+        return false;
+    }
+    out = slot.sample;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == sequence;  // Else lapped mid-copy
+}
+
+bool PoseJitterBuffer::Sample(double targetTime, PoseSample& out, double maxExtrapolation) const
+{
+    uint32_t n = m_writeSequence.load(std::memory_order_acquire);
+    uint32_t first = m_firstSequence.load(std::memory_order_acquire);
+    uint32_t count = n + 1 - first;
+    if (n == 0 || count == 0 || count > n) {
+        return false;
+    }
+    if (count > kCapacity - 1) {
+        count = kCapacity - 1;  // The slot after n is the next one the producer overwrites
+    }
+
+    PoseSample newer;
+    if (!ReadSlot(n, newer)) {
+        return false;
+    }
+    if (targetTime >= newer.timestamp) {
+        out = newer;  // Ahead of the data: hold the newest pose...
+        if (maxExtrapolation > 0.0) {
+            // ...or continue its motion. Baseline of at least half a sample interval,
+            // so two packets that arrived back to back don't give a wild velocity.
+            const double minBaseline = GetSampleInterval() * 0.5;
+            PoseSample older;
+            for (uint32_t i = 1; i < count && i <= 3; i++) {
+                if (!ReadSlot(n - i, older)) {
+                    break;
+                }
+                double baseline = newer.timestamp - older.timestamp;
+                if (baseline >= minBaseline) {
+                    double ahead = targetTime - newer.timestamp;
+                    if (ahead > maxExtrapolation) {
+                        ahead = maxExtrapolation;
+                    }
+                    float t = (float)((baseline + ahead) / baseline);
+                    out.timestamp = newer.timestamp + ahead;
+                    for (int device = 0; device < kPose_Count; device++) {
+                        InterpolatePose(older.poses[device], newer.poses[device], t, out.poses[device]);
+                    }
+                    break;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Walk back to the first sample at or before the target; usually 1-3 steps
+    PoseSample older;
+    for (uint32_t i = 1; i < count; i++) {
+        if (!ReadSlot(n - i, older)) {
+            break;
+        }
+        if (older.timestamp <= targetTime) {
+            float t = (float)((targetTime - older.timestamp) / (newer.timestamp - older.timestamp));
+            out.timestamp = targetTime;
+            for (int device = 0; device < kPose_Count; device++) {
+                InterpolatePose(older.poses[device], newer.poses[device], t, out.poses[device]);
+            }
+            return true;
+        }
+        newer = older;
+    }
+
+    out = newer;  // Behind everything held: oldest pose we have
+    return true;
+}
+
+double PoseJitterBuffer::GetPlayoutDelay() const
+{
+    return GetDepth() * GetSampleInterval();
+}
+
+} // namespace FNVR
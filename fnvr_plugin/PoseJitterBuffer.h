@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "VRPacketView.h"
+
+namespace FNVR {
+
+enum PoseDevice {
+    kPose_Hmd = 0,
+    kPose_Right = 1,
+    kPose_Left = 2,
+    kPose_Count = 3
+};
+
+// The tracked poses of one packet, stamped with the tracker's clock (seconds)
+struct PoseSample {
+    double timestamp;
+    VRPose poses[kPose_Count];
+};
+
+// Position lerp and shortest-path quaternion slerp; t = 0 gives a, t = 1 gives b
+void InterpolatePose(const VRPose& a, const VRPose& b, float t, VRPose& out);
+
+// Timestamp-ordered history of the most recent tracker poses, resampled at any time.
+//
+// The tracker sends at a nominal 120 Hz with time.sleep() jitter and the apply stage
+// runs on its own cadence, so "newest packet" steps unevenly from frame to frame.
+// Sampling the history a fixed playout delay (depth x measured sample interval)
+// behind the tracker's clock instead keeps the target time bracketed by two real
+// samples, which are then interpolated.
+//
+// One producer (the pipe thread) pushes, one consumer samples. Slots use the same
+// per-slot seqlock as SharedPoseRing, so neither side blocks.
+class PoseJitterBuffer
+{
+public:
+    PoseJitterBuffer();
+
+    static const uint32_t kCapacity = 32;              // ~260 ms at 120 Hz
+    static const uint32_t kMaxDepth = 8;
+    static const uint32_t kNominalIntervalUs = 8333;   // Until the tracker rate is measured
+
+    // Playout delay in samples; 0 = no buffering (newest sample only)
+    void SetDepth(uint32_t depth);
+    uint32_t GetDepth() const { return m_depth.load(std::memory_order_relaxed); }
+
+    // --- Producer side ---
+
+    // Appends a packet's poses. Samples not newer than the last one are dropped; a
+    // large backwards jump (tracker restart, looping replay) starts a new history.
+    bool Push(const VRPacketView& packet);
+
+    // Forget everything pushed so far (new tracker session)
+    void Reset();
+
+    // --- Consumer side ---
+
+    // Pose at targetTime (tracker clock). Between two samples the bracketing pair is
+    // interpolated. Past the newest sample the motion of the last two is continued
+    // for at most maxExtrapolation seconds (0 = hold the newest pose); before the
+    // oldest, the oldest is held. out.timestamp receives the time actually represented.
+    // Returns false while the history is empty.
+    bool Sample(double targetTime, PoseSample& out, double maxExtrapolation = 0.0) const;
+
+    // Latency the buffer adds: depth x smoothed interval between samples, in seconds
+    double GetPlayoutDelay() const;
+    double GetSampleInterval() const { return m_intervalUs.load(std::memory_order_relaxed) * 1e-6; }
+
+    // Samples rejected because they arrived out of timestamp order
+    uint32_t GetOutOfOrderCount() const { return m_outOfOrder.load(std::memory_order_relaxed); }
+
+    static const double kDiscontinuitySeconds;  // Backwards jump treated as a new stream
+    static const double kMaxIntervalSeconds;    // Longer gaps are pauses, not the sample rate
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> sequence;  // Sample number stored here, 0 while being written
+        PoseSample sample;
+    };
+
+    bool ReadSlot(uint32_t sequence, PoseSample& out) const;
+
+    Slot m_slots[kCapacity];
+    std::atomic<uint32_t> m_writeSequence;  // Newest complete sample, 0 = none yet
+    std::atomic<uint32_t> m_firstSequence;  // Oldest sample of the current stream
+    std::atomic<uint32_t> m_intervalUs;
+    std::atomic<uint32_t> m_depth;
+    std::atomic<uint32_t> m_outOfOrder;
+
+    // Producer only
+    double m_newestTimestamp;
+    double m_interval;
+};
+
+} // namespace FNVR
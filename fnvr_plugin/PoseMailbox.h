@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace FNVR {
+
+// Wait-free single-producer / single-consumer "latest value" mailbox (triple buffer).
+//
+// Three slots rotate between the producer (back), the hand-off (middle) and the
+// consumer (front). Publishing swaps back<->middle, acquiring swaps middle<->front,
+// each with a single atomic exchange, so neither side ever blocks or retries and the
+// consumer always sees the newest fully written value. Intermediate values the
+// consumer never acquired are simply overwritten (latest wins).
+//
+// Platform-neutral on purpose: no Win32 types, so it can be exercised off-game.
+template <typename T>
+class PoseMailbox {
+public:
+    PoseMailbox() : m_middle(1), m_back(0), m_published(0), m_front(2) {}
+
+    // --- Producer side (one thread) ---
+
+    // Slot owned by the producer; fill it in place, then call Publish().
+    // Not publishing simply leaves the slot to be overwritten next time.
+    T& BeginWrite() { return m_slots[m_back].value; }
+
+    void Publish() {
+        m_back = static_cast<uint8_t>(
+            m_middle.exchange(static_cast<uint8_t>(m_back | kDirtyBit), std::memory_order_acq_rel) & kIndexMask);
+        // Only this thread writes the counter, so no locked read-modify-write is needed
+        m_published.store(m_published.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void Publish(const T& value) {
+        BeginWrite() = value;
+        Publish();
+    }
+
+    // --- Consumer side (one thread) ---
+
+    // Takes ownership of the newest published value if there is one.
+    // Returns false (and leaves Front() untouched) when nothing new arrived.
+    bool Acquire() {
+        if (!(m_middle.load(std::memory_order_relaxed) & kDirtyBit)) {
+            return false;
+        }
+        m_front = static_cast<uint8_t>(m_middle.exchange(m_front, std::memory_order_acq_rel) & kIndexMask);
+        return true;
+    }
+
+    // Last acquired value; stays valid until the next Acquire() on the consumer thread.
+    const T& Front() const { return m_slots[m_front].value; }
+
+    bool HasNew() const { return (m_middle.load(std::memory_order_relaxed) & kDirtyBit) != 0; }
+
+    // Total number of Publish() calls, readable from any thread (stats only).
+    uint64_t PublishedCount() const { return m_published.load(std::memory_order_relaxed); }
+
+private:
+    static const uint8_t kIndexMask = 0x03;
+    static const uint8_t kDirtyBit = 0x04;
+
+    // Each slot on its own cache line so producer writes don't false-share with consumer reads
+    struct alignas(64) Slot {
+        T value;
+    };
+
+    Slot m_slots[3];
+    alignas(64) std::atomic<uint8_t> m_middle;  // shared: index | dirty bit
+    alignas(64) uint8_t m_back;                 // producer-owned index
+    std::atomic<uint64_t> m_published;          // producer-written counter
+    alignas(64) uint8_t m_front;                // consumer-owned index
+};
+
+} // namespace FNVR
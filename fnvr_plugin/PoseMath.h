@@ -0,0 +1,148 @@
+#pragma once
+
+#include <emmintrin.h>
+
+// SSE kernels for the pose math shared by the apply path, VRManager and NVCSSkeleton.
+//
+// A quaternion lives in one register with lanes (w, x, y, z) - the memory order of
+// VRPose::qw..qz and HmdQuaternionf_t - so it loads and stores with a single unaligned
+// move. A 3x3 rotation or 3x4 affine is three row registers; lane 3 of a row is the
+// translation (0 for a pure rotation).
+//
+// SSE2 at most (the MSVC x86 default since VS2012). Free of game and OpenVR types,
+// so it builds and tests anywhere.
+
+namespace FNVR {
+
+// --- Quaternions ---
+
+inline __m128 LoadQuat(const float* wxyz) { return _mm_loadu_ps(wxyz); }
+inline void StoreQuat(float* wxyz, __m128 q) { _mm_storeu_ps(wxyz, q); }
+
+inline __m128 MakeQuat(float w, float x, float y, float z) { return _mm_setr_ps(w, x, y, z); }
+
+// Inverse of a unit quaternion
+inline __m128 QuatConjugate(__m128 q) { return _mm_mul_ps(q, _mm_setr_ps(1.0f, -1.0f, -1.0f, -1.0f)); }
+
+// Hamilton product a * b (apply b, then a)
+inline __m128 QuatMultiply(__m128 a, __m128 b)
+{
+    // Each of a's components times b rearranged so lane i lines up with result lane i
+    const __m128 signX = _mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f);
+    const __m128 signY = _mm_setr_ps(-1.0f, 1.0f, 1.0f, -1.0f);
+    const __m128 signZ = _mm_setr_ps(-1.0f, -1.0f, 1.0f, 1.0f);
+
+    __m128 r = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), b);
+    __m128 bx = _mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), signX);  // (x, w, z, y)
+    __m128 by = _mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)), signY);  // (y, z, w, x)
+    __m128 bz = _mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)), signZ);  // (z, y, x, w)
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), bx));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), by));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), bz));
+    return r;
+}
+
+// Sum of the four lanes, in every lane
+inline __m128 HorizontalSum(__m128 v)
+{
+    __m128 pairs = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_add_ps(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+// Unit length; a zero quaternion is returned unchanged
+inline __m128 QuatNormalize(__m128 q)
+{
+    __m128 lengthSq = HorizontalSum(_mm_mul_ps(q, q));
+    // Full-precision sqrt and divide: rsqrt's 12 bits would leave visible drift
+    __m128 scaled = _mm_div_ps(q, _mm_sqrt_ps(lengthSq));
+    __m128 nonZero = _mm_cmpgt_ps(lengthSq, _mm_setzero_ps());
+    return _mm_or_ps(_mm_and_ps(nonZero, scaled), _mm_andnot_ps(nonZero, q));
+}
+
+// --- Rotation matrices ---
+
+struct MatrixRows {
+    __m128 row[3];  // Lane 3: translation
+};
+
+// Rotation matrix of a unit quaternion (column vectors: v' = M v), translation 0
+inline void QuatToRows(__m128 q, MatrixRows& out)
+{
+    const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+    __m128 q2 = _mm_add_ps(q, q);                                                 // (2w, 2x, 2y, 2z)
+    __m128 sq2 = _mm_mul_ps(q, q2);                                               // (2ww, 2xx, 2yy, 2zz)
+
+    // Diagonal (1 - 2yy - 2zz, 1 - 2xx - 2zz, 1 - 2xx - 2yy)
+    __m128 diag = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_shuffle_ps(sq2, sq2, _MM_SHUFFLE(0, 1, 1, 2)));
+    diag = _mm_sub_ps(diag, _mm_shuffle_ps(sq2, sq2, _MM_SHUFFLE(0, 2, 3, 3)));
+
+    // (2xz, 2xy, 2yz) and (2wy, 2wz, 2wx); off-diagonals are their sums and differences
+    __m128 cross = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(0, 2, 1, 1)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(0, 3, 2, 3)));
+    __m128 wTerms = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(0, 1, 3, 2)));
+    __m128 plus = _mm_add_ps(cross, wTerms);    // (2(xz+wy), 2(xy+wz), 2(yz+wx))
+    __m128 minus = _mm_sub_ps(cross, wTerms);   // (2(xz-wy), 2(xy-wz), 2(yz-wx))
+
+    // row0 = (diag0, minus1, plus0), row1 = (plus1, diag1, minus2), row2 = (minus0, plus2, diag2)
+    __m128 t0 = _mm_shuffle_ps(diag, minus, _MM_SHUFFLE(1, 1, 0, 0));
+    __m128 t1 = _mm_shuffle_ps(plus, diag, _MM_SHUFFLE(1, 1, 1, 1));
+    __m128 t2 = _mm_shuffle_ps(minus, plus, _MM_SHUFFLE(2, 2, 0, 0));
+    out.row[0] = _mm_and_ps(_mm_shuffle_ps(t0, plus, _MM_SHUFFLE(0, 0, 2, 0)), xyzMask);
+    out.row[1] = _mm_and_ps(_mm_shuffle_ps(t1, minus, _MM_SHUFFLE(2, 2, 2, 0)), xyzMask);
+    out.row[2] = _mm_and_ps(_mm_shuffle_ps(t2, diag, _MM_SHUFFLE(2, 2, 2, 0)), xyzMask);
+}
+
+// float[3][4] (HmdMatrix34_t::m) <-> rows
+inline void LoadRows34(const float* m, MatrixRows& out)
+{
+    out.row[0] = _mm_loadu_ps(m);
+    out.row[1] = _mm_loadu_ps(m + 4);
+    out.row[2] = _mm_loadu_ps(m + 8);
+}
+
+inline void StoreRows34(float* m, const MatrixRows& rows)
+{
+    _mm_storeu_ps(m, rows.row[0]);
+    _mm_storeu_ps(m + 4, rows.row[1]);
+    _mm_storeu_ps(m + 8, rows.row[2]);
+}
+
+// Rotation part into a row-major float[3][3] (NiMatrix33); never writes past m[8]
+inline void StoreRows33(float* m, const MatrixRows& rows)
+{
+    _mm_storeu_ps(m, rows.row[0]);       // m[3] is rewritten by row 1
+    _mm_storeu_ps(m + 3, rows.row[1]);   // m[6] is rewritten by row 2
+    _mm_storel_pi(reinterpret_cast<__m64*>(m + 6), rows.row[2]);
+    _mm_store_ss(m + 8, _mm_movehl_ps(rows.row[2], rows.row[2]));
+}
+
+// Affine a * b: rotation Ra Rb, translation Ra tb + ta
+inline void ComposeRows(const MatrixRows& a, const MatrixRows& b, MatrixRows& out)
+{
+    const __m128 wOnly = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+    MatrixRows result;
+    for (int i = 0; i < 3; i++) {
+        __m128 row = a.row[i];
+        __m128 r = _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), b.row[0]);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), b.row[1]));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), b.row[2]));
+        result.row[i] = _mm_add_ps(r, _mm_and_ps(row, wOnly));
+    }
+    out = result;  // out may alias a or b
+}
+
+// M (x, y, z, 1): out[i] = row i . (p, 1)
+inline void TransformPoint(const MatrixRows& m, const float* p, float* out)
+{
+    __m128 v = _mm_setr_ps(p[0], p[1], p[2], 1.0f);
+    __m128 r0 = _mm_mul_ps(m.row[0], v);
+    __m128 r1 = _mm_mul_ps(m.row[1], v);
+    __m128 r2 = _mm_mul_ps(m.row[2], v);
+    __m128 r3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    __m128 sum = _mm_add_ps(_mm_add_ps(r0, r1), _mm_add_ps(r2, r3));
+    _mm_storel_pi(reinterpret_cast<__m64*>(out), sum);
+    _mm_store_ss(out + 2, _mm_movehl_ps(sum, sum));
+}
+
+} // namespace FNVR
@@ -0,0 +1,349 @@
+// fnvr_plugin/ReplayTrackingSource.cpp
+#include "ReplayTrackingSource.h"
+#include <cstring>
+#include <thread>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Basit log makrosu
+#ifndef _MESSAGE
+#define _MESSAGE(fmt, ...) ((void)0)
+#endif
+
+namespace {
+
+bool IndexEntryBefore(const FNVR::SessionIndexEntry& entry, uint64_t timeNs)
+{
+    return entry.receiveTimeNs < timeNs;
+}
+
+} // namespace
+
+ReplayTrackingSource::ReplayTrackingSource(const std::string& path, float speed, bool loop)
+    : m_path(path), m_speed(speed), m_loop(loop), m_isConnected(false), m_finished(false),
+      m_packetsReplayed(0), m_data(nullptr), m_size(0), m_fileHandle(nullptr), m_mappingHandle(nullptr),
+      m_isSession(false), m_recordsBegin(0), m_recordsEnd(0), m_offset(0), m_startSeconds(0.0),
+      m_hasOrigin(false), m_originSeconds(0.0) {}
+
+ReplayTrackingSource::~ReplayTrackingSource()
+{
+    Disconnect();
+}
+
+bool ReplayTrackingSource::MapFile()
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(m_path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_size = (size_t)fileSize.QuadPart;
+#else
+    int fd = open(m_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps the file alive
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    m_size = (size_t)st.st_size;
+#endif
+    m_data = static_cast<const unsigned char*>(view);
+    return true;
+}
+
+void ReplayTrackingSource::UnmapFile()
+{
+#ifdef _WIN32
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mappingHandle) CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    if (m_fileHandle) CloseHandle(static_cast<HANDLE>(m_fileHandle));
+#else
+    if (m_data) munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_fileHandle = nullptr;
+    m_mappingHandle = nullptr;
+}
+
+// Uses the recording's own index when it was closed properly, otherwise scans the
+// records once (a crash leaves every record intact but no index).
+void ReplayTrackingSource::BuildIndex()
+{
+    m_index.clear();
+
+    FNVR::SessionFileHeader header;
+    memcpy(&header, m_data, sizeof(header));
+    m_recordsBegin = header.headerSize;
+    m_recordsEnd = m_size;
+
+    size_t indexBytes = (size_t)header.indexCount * sizeof(FNVR::SessionIndexEntry);
+    if (header.indexOffset != 0 && header.indexOffset >= m_recordsBegin &&
+        header.indexOffset <= m_size && indexBytes <= m_size - (size_t)header.indexOffset) {
+        m_recordsEnd = (size_t)header.indexOffset;
+        m_index.resize(header.indexCount);
+        if (indexBytes) {
+            memcpy(&m_index[0], m_data + header.indexOffset, indexBytes);
+        }
+        return;
+    }
+
+    _MESSAGE("FNVR | Replay: %s has no index (recording not closed), rebuilding", m_path.c_str());
+    uint32_t records = 0;
+    for (size_t offset = m_recordsBegin; offset + sizeof(FNVR::SessionRecordHeader) <= m_size; records++) {
+        FNVR::SessionRecordHeader record;
+        memcpy(&record, m_data + offset, sizeof(record));
+        size_t next = offset + sizeof(record) + record.packetSize;
+        if (next > m_size) {
+            break;  // Torn final record
+        }
+        if (records % FNVR::SESSION_INDEX_INTERVAL == 0) {
+            FNVR::SessionIndexEntry entry = { record.receiveTimeNs, offset };
+            m_index.push_back(entry);
+        }
+        offset = next;
+        m_recordsEnd = next;
+    }
+}
+
+bool ReplayTrackingSource::Connect()
+{
+    if (m_isConnected) {
+        return true;
+    }
+    if (m_finished || !MapFile()) {
+        return false;
+    }
+
+    uint32_t magic = 0;
+    if (m_size >= sizeof(FNVR::SessionFileHeader)) {
+        memcpy(&magic, m_data, sizeof(magic));
+    }
+    m_isSession = magic == FNVR::SESSION_FILE_MAGIC;
+    if (m_isSession) {
+        FNVR::SessionFileHeader header;
+        memcpy(&header, m_data, sizeof(header));
+        if (header.version != FNVR::SESSION_FILE_VERSION || header.headerSize < sizeof(header) || header.headerSize > m_size) {
+            _MESSAGE("FNVR | Replay: unsupported session recording version %u", header.version);
+            m_finished = true;
+            UnmapFile();
+            return false;
+        }
+        BuildIndex();
+    } else {
+        m_index.clear();
+        m_recordsBegin = 0;
+        m_recordsEnd = m_size;
+    }
+
+    m_isConnected = true;
+    Rewind();
+    _MESSAGE("FNVR | Replaying %s (%s, %u bytes, speed %.2f)", m_path.c_str(),
+        m_isSession ? "session recording" : "raw packet stream", (unsigned)m_size, m_speed);
+    return true;
+}
+
+void ReplayTrackingSource::Disconnect()
+{
+    if (m_isConnected) {
+        m_isConnected = false;
+        _MESSAGE("FNVR | Replay stopped after %u packets.", m_packetsReplayed);
+    }
+    UnmapFile();
+}
+
+bool ReplayTrackingSource::IsConnected() const
+{
+    return m_isConnected;
+}
+
+// Back to where the replay starts: the SeekToTime() position if one was set, else
+// the first record. Used on connect and each time a looping replay wraps around.
+void ReplayTrackingSource::Rewind()
+{
+    m_offset = m_recordsBegin;
+    m_hasOrigin = false;
+    if (m_startSeconds > 0.0) {
+        SeekToTime(m_startSeconds);
+    }
+}
+
+bool ReplayTrackingSource::SeekToTime(double seconds)
+{
+    if (!m_isConnected || !m_isSession || m_index.empty()) {
+        return false;
+    }
+
+    // Index narrows it to one block of SESSION_INDEX_INTERVAL records, then scan
+    uint64_t targetNs = seconds > 0.0 ? (uint64_t)(seconds * 1e9) : 0;
+    std::vector<FNVR::SessionIndexEntry>::const_iterator it =
+        std::lower_bound(m_index.begin(), m_index.end(), targetNs, IndexEntryBefore);
+    if (it != m_index.begin()) {
+        --it;
+    }
+
+    size_t offset = (size_t)it->offset;
+    while (offset + sizeof(FNVR::SessionRecordHeader) <= m_recordsEnd) {
+        FNVR::SessionRecordHeader record;
+        memcpy(&record, m_data + offset, sizeof(record));
+        if (record.receiveTimeNs >= targetNs) {
+            break;
+        }
+        offset += sizeof(record) + record.packetSize;
+    }
+
+    m_offset = offset;
+    m_hasOrigin = false;
+    m_startSeconds = seconds;
+    return true;
+}
+
+double ReplayTrackingSource::GetDurationSeconds() const
+{
+    if (!m_isSession || m_index.empty()) {
+        return 0.0;
+    }
+    // Last indexed record is at most SESSION_INDEX_INTERVAL records from the end
+    uint64_t lastNs = m_index.back().receiveTimeNs;
+    for (size_t offset = (size_t)m_index.back().offset; offset + sizeof(FNVR::SessionRecordHeader) <= m_recordsEnd; ) {
+        FNVR::SessionRecordHeader record;
+        memcpy(&record, m_data + offset, sizeof(record));
+        lastNs = record.receiveTimeNs;
+        offset += sizeof(record) + record.packetSize;
+    }
+    return lastNs * 1e-9;
+}
+
+// Next packet in file order. receiveTimeNs is only meaningful for session recordings.
+bool ReplayTrackingSource::NextRecord(const unsigned char*& packet, uint32_t& size, uint64_t& receiveTimeNs)
+{
+    if (m_isSession) {
+        if (m_offset + sizeof(FNVR::SessionRecordHeader) > m_recordsEnd) {
+            return false;
+        }
+        FNVR::SessionRecordHeader record;
+        memcpy(&record, m_data + m_offset, sizeof(record));
+        size_t packetOffset = m_offset + sizeof(record);
+        if (packetOffset + record.packetSize > m_recordsEnd) {
+            return false;
+        }
+        packet = m_data + packetOffset;
+        size = record.packetSize;
+        receiveTimeNs = record.receiveTimeNs;
+        m_offset = packetOffset + record.packetSize;
+        return true;
+    }
+
+    if (m_offset + 2 > m_recordsEnd) {
+        return false;
+    }
+    size = GetWirePacketSize(GetWirePacketVersion(m_data + m_offset));
+    if (size == 0 || m_offset + size > m_recordsEnd) {
+        // Truncated capture or not a packet stream: nothing after this point can be trusted
+        _MESSAGE("FNVR | Replay: bad packet at offset %u, stopping", (unsigned)m_offset);
+        m_offset = m_recordsEnd;
+        return false;
+    }
+    packet = m_data + m_offset;
+    receiveTimeNs = 0;
+    m_offset += size;
+    return true;
+}
+
+// Sleeps in short steps so a stop request is noticed promptly. Returns false if stopping.
+bool ReplayTrackingSource::WaitUntil(std::chrono::steady_clock::time_point deadline) const
+{
+    const std::chrono::milliseconds step(5);
+    while (!IsStopRequested()) {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return true;
+        }
+        std::this_thread::sleep_for(deadline - now < step ? deadline - now : std::chrono::steady_clock::duration(step));
+    }
+    return false;
+}
+
+bool ReplayTrackingSource::Read(WirePacket& packet)
+{
+    if (!m_isConnected || IsStopRequested()) {
+        return false;
+    }
+
+    const unsigned char* raw = nullptr;
+    uint32_t size = 0;
+    uint64_t receiveTimeNs = 0;
+    while (true) {
+        if (!NextRecord(raw, size, receiveTimeNs)) {
+            if (!m_loop || m_packetsReplayed == 0) {
+                m_finished = true;
+                Disconnect();
+                return false;
+            }
+            Rewind();
+            continue;
+        }
+        if (IsWirePacketValid(raw, size)) {
+            break;
+        }
+        // Recorded as received, e.g. a packet from before a reconnect: skip it
+    }
+
+    memcpy(packet.data, raw, size);
+    packet.size = size;
+
+    if (m_speed > 0.0f) {
+        double packetSeconds = m_isSession ? receiveTimeNs * 1e-9 : VRPacketView(packet).GetTimestamp();
+        if (!m_hasOrigin) {
+            m_hasOrigin = true;
+            m_originSeconds = packetSeconds;
+            m_originTime = std::chrono::steady_clock::now();
+        } else {
+            double offsetSeconds = (packetSeconds - m_originSeconds) / m_speed;
+            if (offsetSeconds > 0.0) {
+                std::chrono::steady_clock::time_point deadline = m_originTime +
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(offsetSeconds));
+                if (!WaitUntil(deadline)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    m_packetsReplayed++;
+    return true;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include "TrackingSource.h"
+#include "SessionRecording.h"
+
+// Replays a capture through the normal ingest path. Two file layouts are accepted:
+//   - .fnvrec session recordings (SessionRecording.h), paced by receive times and
+//     seekable through the file's index
+//   - raw V2/V3 wire packets stored back to back, exactly as they travel over the
+//     pipe, paced by the packets' own timestamps
+// The file is memory-mapped; each packet is copied once, into the caller's slot.
+// `speed` scales the original timing (1.0 = real time, 2.0 = twice as fast,
+// 0 = as fast as possible), so the same source serves reproduction and load tests.
+class ReplayTrackingSource : public ITrackingSource
+{
+public:
+    ReplayTrackingSource(const std::string& path, float speed = 1.0f, bool loop = false);
+    ~ReplayTrackingSource();
+
+    bool Connect() override;       // Maps the file; fails once a non-looping replay has finished
+    void Disconnect() override;
+    bool IsConnected() const override;
+    bool Read(WirePacket& packet) override;
+    const char* GetName() const override { return "replay"; }
+
+    // Session recordings only: continue from the first packet received at or after
+    // `seconds` into the recording. Pacing restarts from that packet, and a looping
+    // replay comes back to it instead of the start of the file.
+    bool SeekToTime(double seconds);
+    double GetDurationSeconds() const;
+
+    uint32_t GetPacketsReplayed() const { return m_packetsReplayed; }
+
+private:
+    bool MapFile();
+    void UnmapFile();
+    void BuildIndex();
+    bool NextRecord(const unsigned char*& packet, uint32_t& size, uint64_t& receiveTimeNs);
+    void Rewind();
+    bool WaitUntil(std::chrono::steady_clock::time_point deadline) const;
+
+    std::string m_path;
+    float m_speed;
+    bool m_loop;
+    bool m_isConnected;
+    bool m_finished;
+    uint32_t m_packetsReplayed;
+
+    // Mapping
+    const unsigned char* m_data;
+    size_t m_size;
+    void* m_fileHandle;     // HANDLEs on Windows, unused on POSIX
+    void* m_mappingHandle;
+
+    // Layout
+    bool m_isSession;
+    size_t m_recordsBegin;
+    size_t m_recordsEnd;
+    std::vector<FNVR::SessionIndexEntry> m_index;
+    size_t m_offset;
+    double m_startSeconds;  // Last SeekToTime() target, where loops restart
+
+    // Pacing origin: first replayed packet's time and when it was played
+    bool m_hasOrigin;
+    double m_originSeconds;
+    std::chrono::steady_clock::time_point m_originTime;
+};
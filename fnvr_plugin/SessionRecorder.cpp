@@ -0,0 +1,94 @@
+// fnvr_plugin/SessionRecorder.cpp
+#include "SessionRecording.h"
+#include <cstring>
+#include "VRDataPacket.h"
+
+// Basit log makrosu
+#ifndef _MESSAGE
+#define _MESSAGE(fmt, ...) ((void)0)
+#endif
+
+namespace FNVR {
+
+SessionRecorder::SessionRecorder()
+    : m_file(nullptr), m_offset(0), m_recordCount(0) {}
+
+SessionRecorder::~SessionRecorder()
+{
+    Close();
+}
+
+bool SessionRecorder::Open(const std::string& path)
+{
+    Close();
+
+    m_file = fopen(path.c_str(), "wb");
+    if (!m_file) {
+        _MESSAGE("FNVR | Could not create session recording: %s", path.c_str());
+        return false;
+    }
+    m_writeBuffer.resize(64 * 1024);
+    setvbuf(m_file, &m_writeBuffer[0], _IOFBF, m_writeBuffer.size());
+
+    memset(&m_header, 0, sizeof(m_header));
+    m_header.magic = SESSION_FILE_MAGIC;
+    m_header.version = SESSION_FILE_VERSION;
+    m_header.headerSize = sizeof(SessionFileHeader);
+    m_header.startTimeUnixUs = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    fwrite(&m_header, sizeof(m_header), 1, m_file);
+
+    m_offset = sizeof(m_header);
+    m_recordCount = 0;
+    m_index.clear();
+    m_startTime = std::chrono::steady_clock::now();
+    _MESSAGE("FNVR | Recording tracking session to %s", path.c_str());
+    return true;
+}
+
+void SessionRecorder::Record(const void* packet, uint32_t size)
+{
+    if (!m_file || size == 0 || size > VR_MAX_WIRE_PACKET_SIZE) {
+        return;
+    }
+
+    SessionRecordHeader record;
+    record.receiveTimeNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - m_startTime).count();
+    record.packetSize = (uint16_t)size;
+
+    if (m_recordCount % SESSION_INDEX_INTERVAL == 0) {
+        SessionIndexEntry entry = { record.receiveTimeNs, m_offset };
+        m_index.push_back(entry);
+    }
+
+    fwrite(&record, sizeof(record), 1, m_file);
+    fwrite(packet, 1, size, m_file);
+    m_offset += sizeof(record) + size;
+    m_recordCount++;
+}
+
+void SessionRecorder::Close()
+{
+    if (!m_file) {
+        return;
+    }
+
+    if (!m_index.empty()) {
+        fwrite(&m_index[0], sizeof(SessionIndexEntry), m_index.size(), m_file);
+    }
+
+    // Finalize the header in place; until now indexOffset was 0 ("not closed")
+    SessionFileHeader header = m_header;
+    header.indexOffset = m_offset;
+    header.indexCount = (uint32_t)m_index.size();
+    header.recordCount = m_recordCount;
+    fseek(m_file, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, m_file);
+
+    fclose(m_file);
+    m_file = nullptr;
+    _MESSAGE("FNVR | Session recording closed (%u packets)", m_recordCount);
+}
+
+} // namespace FNVR
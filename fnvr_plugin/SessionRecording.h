@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <chrono>
+
+namespace FNVR {
+
+// Binary tracking-session capture (.fnvrec), written by SessionRecorder on the pipe
+// thread and replayed by ReplayTrackingSource.
+//
+//   SessionFileHeader (32 bytes)
+//   record*           SessionRecordHeader (10 bytes) + raw V2/V3 wire packet
+//   SessionIndexEntry[indexCount] at indexOffset (appended when the file is closed)
+//
+// receiveTimeNs is steady-clock time since the recording started, taken when the
+// plugin received the packet. Every SESSION_INDEX_INTERVAL-th record is indexed so
+// a replay can seek without scanning; a file whose recorder never closed it has
+// indexOffset == 0 and is re-indexed by scanning on load.
+static const uint32_t SESSION_FILE_MAGIC = 0x53564E46;  // "FNVS"
+static const uint16_t SESSION_FILE_VERSION = 1;
+static const uint32_t SESSION_INDEX_INTERVAL = 128;
+
+#pragma pack(push, 1)
+struct SessionFileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;
+    uint64_t indexOffset;     // 0 until the recorder is closed
+    uint32_t indexCount;
+    uint32_t recordCount;
+    uint64_t startTimeUnixUs; // Wall clock at the start of the recording (informational)
+};
+
+struct SessionRecordHeader {
+    uint64_t receiveTimeNs;
+    uint16_t packetSize;
+};
+
+struct SessionIndexEntry {
+    uint64_t receiveTimeNs;
+    uint64_t offset;          // File offset of the record's SessionRecordHeader
+};
+#pragma pack(pop)
+
+static_assert(sizeof(SessionFileHeader) == 32, "SessionFileHeader is a file format");
+static_assert(sizeof(SessionRecordHeader) == 10, "SessionRecordHeader is a file format");
+static_assert(sizeof(SessionIndexEntry) == 16, "SessionIndexEntry is a file format");
+
+// Appends every packet a tracking source receives. Single thread (the pipe thread);
+// writes go through a large stdio buffer so recording costs one memcpy per packet.
+class SessionRecorder
+{
+public:
+    SessionRecorder();
+    ~SessionRecorder();
+
+    bool Open(const std::string& path);
+    void Close();  // Writes the index and finalizes the header
+    bool IsOpen() const { return m_file != nullptr; }
+
+    void Record(const void* packet, uint32_t size);
+
+    uint32_t GetRecordCount() const { return m_recordCount; }
+
+private:
+    FILE* m_file;
+    SessionFileHeader m_header;
+    uint64_t m_offset;
+    uint32_t m_recordCount;
+    std::chrono::steady_clock::time_point m_startTime;
+    std::vector<SessionIndexEntry> m_index;
+    std::vector<char> m_writeBuffer;
+};
+
+} // namespace FNVR
@@ -0,0 +1,319 @@
+// fnvr_plugin/SharedMemoryClient.cpp
+#include "SharedMemoryClient.h"
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
+// Basit log makrosu
+#ifndef _MESSAGE
+#define _MESSAGE(fmt, ...) ((void)0)
+#endif
+
+namespace {
+
+#ifdef _WIN32
+std::string NewDataEventName(const std::string& mappingName)
+{
+    return mappingName + "_NewData";
+}
+#else
+std::string PosixShmName(const std::string& name)
+{
+    return (!name.empty() && name[0] == '/') ? name : "/" + name;
+}
+#endif
+
+#ifdef __linux__
+// Shared (not process-private) futex on a word of the mapping
+long Futex(std::atomic<uint32_t>* word, int op, uint32_t value, const timespec* timeout)
+{
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, value, timeout, nullptr, 0);
+}
+#endif
+
+uint32_t CurrentProcessId()
+{
+#ifdef _WIN32
+    return (uint32_t)GetCurrentProcessId();
+#else
+    return (uint32_t)getpid();
+#endif
+}
+
+// Maps the ring; create=true for the writer side. Returns nullptr on failure.
+FNVR::SharedPoseRing* MapRing(const std::string& name, bool create, void*& handleOut)
+{
+    const size_t size = sizeof(FNVR::SharedPoseRing);
+    handleOut = nullptr;
+
+#ifdef _WIN32
+    HANDLE mapping = create
+        ? CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)size, name.c_str())
+        : OpenFileMappingA(FILE_MAP_READ | FILE_MAP_WRITE, FALSE, name.c_str());
+    if (!mapping) {
+        return nullptr;
+    }
+
+    void* view = MapViewOfFile(mapping, create ? FILE_MAP_ALL_ACCESS : (FILE_MAP_READ | FILE_MAP_WRITE), 0, 0, size);
+    if (!view) {
+        CloseHandle(mapping);
+        return nullptr;
+    }
+    handleOut = mapping;
+    return static_cast<FNVR::SharedPoseRing*>(view);
+#else
+    std::string shmName = PosixShmName(name);
+    int fd = shm_open(shmName.c_str(), create ? (O_CREAT | O_RDWR) : O_RDWR, 0600);
+    if (fd < 0) {
+        return nullptr;
+    }
+    if (create && ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    // Read-write on both sides: the reader sets header.readerWaiting
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps the object alive
+    if (view == MAP_FAILED) {
+        return nullptr;
+    }
+    return static_cast<FNVR::SharedPoseRing*>(view);
+#endif
+}
+
+void UnmapRing(FNVR::SharedPoseRing* ring, void* handle)
+{
+#ifdef _WIN32
+    if (ring) UnmapViewOfFile(ring);
+    if (handle) CloseHandle(static_cast<HANDLE>(handle));
+#else
+    (void)handle;
+    if (ring) munmap(ring, sizeof(FNVR::SharedPoseRing));
+#endif
+}
+
+} // namespace
+
+SharedMemoryClient::SharedMemoryClient(const std::string& mappingName)
+    : m_mappingName(mappingName), m_mappingHandle(nullptr), m_newDataEvent(nullptr), m_writerProcess(nullptr),
+      m_ring(nullptr), m_writerPid(0), m_lastSequence(0), m_droppedPackets(0), m_isConnected(false) {}
+
+SharedMemoryClient::~SharedMemoryClient()
+{
+    Disconnect();
+}
+
+bool SharedMemoryClient::Connect()
+{
+    if (m_isConnected) {
+        return true;
+    }
+
+    m_ring = MapRing(m_mappingName, false, m_mappingHandle);
+    if (!m_ring) {
+        return false;
+    }
+
+    m_writerPid = FNVR::IsSharedPoseRingValid(m_ring) ? m_ring->header.writerPid.load(std::memory_order_acquire) : 0;
+    if (m_writerPid == 0) {
+        // Writer created the mapping but has not initialized the header yet, or has closed it
+        UnmapRing(m_ring, m_mappingHandle);
+        m_ring = nullptr;
+        m_mappingHandle = nullptr;
+        return false;
+    }
+
+#ifdef _WIN32
+    m_writerProcess = OpenProcess(SYNCHRONIZE, FALSE, m_writerPid);
+    m_newDataEvent = OpenEventA(SYNCHRONIZE, FALSE, NewDataEventName(m_mappingName).c_str());
+#endif
+
+    // Start from whatever is current so a stale sample is not replayed as new
+    m_lastSequence = m_ring->header.writeSequence.load(std::memory_order_acquire);
+    m_isConnected = true;
+    _MESSAGE("FNVR | Connected to shared memory ring: %s", m_mappingName.c_str());
+    return true;
+}
+
+void SharedMemoryClient::Disconnect()
+{
+#ifdef _WIN32
+    if (m_newDataEvent) CloseHandle(static_cast<HANDLE>(m_newDataEvent));
+    if (m_writerProcess) CloseHandle(static_cast<HANDLE>(m_writerProcess));
+#endif
+    m_newDataEvent = nullptr;
+    m_writerProcess = nullptr;
+    if (m_ring) {
+        UnmapRing(m_ring, m_mappingHandle);
+        m_ring = nullptr;
+        m_mappingHandle = nullptr;
+    }
+    if (m_isConnected) {
+        m_isConnected = false;
+        _MESSAGE("FNVR | Disconnected from shared memory ring.");
+    }
+}
+
+bool SharedMemoryClient::IsConnected() const
+{
+    return m_isConnected;
+}
+
+// The writer still owns the ring: it has not closed it and its process is running
+bool SharedMemoryClient::IsWriterAlive() const
+{
+    uint32_t pid = m_ring->header.writerPid.load(std::memory_order_acquire);
+    if (pid != m_writerPid) {
+        return false;  // Closed (0), or another writer took the mapping over
+    }
+#ifdef _WIN32
+    return !m_writerProcess || WaitForSingleObject(static_cast<HANDLE>(m_writerProcess), 0) == WAIT_TIMEOUT;
+#else
+    return kill((pid_t)pid, 0) == 0 || errno != ESRCH;
+#endif
+}
+
+// Sleeps until the writer signals new data or kPollIntervalMs pass
+void SharedMemoryClient::WaitForNewData()
+{
+    // Flag first, then re-check: a writer that stored its packet before seeing the
+    // flag is caught by the check, one after it signals
+    m_ring->header.readerWaiting.store(1, std::memory_order_seq_cst);
+    if (m_ring->header.writeSequence.load(std::memory_order_seq_cst) == m_lastSequence) {
+#ifdef _WIN32
+        if (m_newDataEvent) {
+            WaitForSingleObject(static_cast<HANDLE>(m_newDataEvent), kPollIntervalMs);
+        } else {
+            Sleep(1);  // No signal to wait on: poll, but not often
+        }
+#elif defined(__linux__)
+        // Returns at once if the sequence has moved on since the check
+        timespec timeout = { 0, kPollIntervalMs * 1000000L };
+        Futex(&m_ring->header.writeSequence, FUTEX_WAIT, m_lastSequence, &timeout);
+#else
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif
+    }
+    m_ring->header.readerWaiting.store(0, std::memory_order_relaxed);
+}
+
+bool SharedMemoryClient::Read(WirePacket& packet)
+{
+    if (!m_isConnected) {
+        return false;
+    }
+
+    // Steady state is a plain memory read. With nothing new the thread sleeps until the
+    // writer signals; a quiet writer (headset off) is waited for, a gone one is not.
+    uint32_t dropped = 0;
+    bool waited = false;
+    while (!FNVR::ReadLatestSharedPose(m_ring, m_lastSequence, packet.data, packet.size, &dropped)) {
+        if (IsStopRequested()) {
+            return false;
+        }
+        // Still nothing after a wait: a timeout (quiet writer) or a signal without data
+        // (closing writer) - either way, check the writer is still there
+        if (waited && !IsWriterAlive()) {
+            _MESSAGE("FNVR | Shared memory writer closed the ring or exited, disconnecting");
+            Disconnect();
+            return false;
+        }
+        WaitForNewData();
+        waited = true;
+    }
+    m_droppedPackets += dropped;
+    RecordPacket(packet.data, packet.size);
+
+    // Every slot carries its own size, so V2 and V3 writers are both accepted
+    if (!IsWirePacketValid(packet.data, packet.size)) {
+        _MESSAGE("FNVR | Warning: Unsupported packet (version %u, %u bytes)", GetWirePacketVersion(packet.data), packet.size);
+        return false;
+    }
+    return true;
+}
+
+SharedMemoryWriter::SharedMemoryWriter(const std::string& mappingName)
+    : m_mappingName(mappingName), m_mappingHandle(nullptr), m_newDataEvent(nullptr), m_ring(nullptr) {}
+
+SharedMemoryWriter::~SharedMemoryWriter()
+{
+    Close();
+}
+
+bool SharedMemoryWriter::Create()
+{
+    if (m_ring) {
+        return true;
+    }
+
+#ifdef _WIN32
+    // Before the header goes valid, so a reader that sees the ring also finds the event
+    m_newDataEvent = CreateEventA(NULL, FALSE, FALSE, NewDataEventName(m_mappingName).c_str());
+#endif
+    m_ring = MapRing(m_mappingName, true, m_mappingHandle);
+    if (!m_ring) {
+        Close();
+        return false;
+    }
+    FNVR::InitSharedPoseRing(m_ring, CurrentProcessId());
+    return true;
+}
+
+void SharedMemoryWriter::Close()
+{
+    if (m_ring) {
+        // Tell a waiting reader the ring is closed rather than just quiet
+        m_ring->header.writerPid.store(0, std::memory_order_release);
+        SignalNewData();
+        UnmapRing(m_ring, m_mappingHandle);
+        m_ring = nullptr;
+        m_mappingHandle = nullptr;
+#ifndef _WIN32
+        shm_unlink(PosixShmName(m_mappingName).c_str());
+#endif
+    }
+#ifdef _WIN32
+    if (m_newDataEvent) {
+        CloseHandle(static_cast<HANDLE>(m_newDataEvent));
+        m_newDataEvent = nullptr;
+    }
+#endif
+}
+
+void SharedMemoryWriter::Write(const void* packet, uint32_t size)
+{
+    if (m_ring && size <= VR_MAX_WIRE_PACKET_SIZE) {
+        FNVR::WriteSharedPoseRing(m_ring, packet, size);
+        SignalNewData();
+    }
+}
+
+void SharedMemoryWriter::SignalNewData()
+{
+    // Pairs with the reader's flag-then-check in WaitForNewData
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!m_ring->header.readerWaiting.load(std::memory_order_relaxed)) {
+        return;
+    }
+#ifdef _WIN32
+    if (m_newDataEvent) SetEvent(static_cast<HANDLE>(m_newDataEvent));
+#elif defined(__linux__)
+    Futex(&m_ring->header.writeSequence, FUTEX_WAKE, INT_MAX, nullptr);
+#endif
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <atomic>
+#include "VRDataPacket.h"
+#include "SharedPoseRing.h"
+#include "TrackingSource.h"
+
+// Shared-memory tracking source. The tracker writes poses into a mapped SharedPoseRing; reading a sample
+// is a seqlock-protected copy out of the mapping, with no kernel transition. With nothing new the
+// reader sleeps on the writer's new-data signal (see SharedPoseRing.h).
+//
+// Backends: Win32 named file mapping ("FNVRTracker") and POSIX shm_open ("/FNVRTracker").
+class SharedMemoryClient : public ITrackingSource
+{
+public:
+    SharedMemoryClient(const std::string& mappingName);
+    ~SharedMemoryClient();
+
+    bool Connect() override;
+    void Disconnect() override;
+    bool IsConnected() const override;
+
+    // Waits for a sample newer than the last one returned, however long the writer is
+    // quiet. Returns false (and disconnects) once the writer has closed the ring or its
+    // process is gone.
+    bool Read(WirePacket& packet) override;
+
+    uint32_t GetDroppedPackets() const override { return m_droppedPackets; }
+    const char* GetName() const override { return "shared memory"; }
+
+    static const int kPollIntervalMs = 100;  // How often a waiting Read() checks the stop flag and the writer
+
+private:
+    bool IsWriterAlive() const;
+    void WaitForNewData();
+
+    std::string m_mappingName;
+    void* m_mappingHandle;  // HANDLE on Windows, unused on POSIX
+    void* m_newDataEvent;   // Windows: the writer's event; nullptr if it has none (then polls)
+    void* m_writerProcess;  // Windows: process handle of the writer
+    FNVR::SharedPoseRing* m_ring;
+    uint32_t m_writerPid;
+    uint32_t m_lastSequence;
+    uint32_t m_droppedPackets;
+    bool m_isConnected;
+};
+
+// Producer side of the ring. Used by native trackers and for benchmarking the
+// transport off-game; fnvr_pose_pipe.py implements the same protocol in Python.
+class SharedMemoryWriter
+{
+public:
+    SharedMemoryWriter(const std::string& mappingName);
+    ~SharedMemoryWriter();
+
+    bool Create();
+    void Close();
+    bool IsOpen() const { return m_ring != nullptr; }
+    void Write(const void* packet, uint32_t size);  // V2 or V3 wire packet
+
+private:
+    void SignalNewData();
+
+    std::string m_mappingName;
+    void* m_mappingHandle;
+    void* m_newDataEvent;  // Windows only
+    FNVR::SharedPoseRing* m_ring;
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include "VRDataPacket.h"
+
+namespace FNVR {
+
+// Shared-memory pose ring written by the tracker and read by the plugin.
+//
+//   header (64 bytes) | slot[0] | slot[1] | ... | slot[SHARED_POSE_RING_SLOTS - 1]
+//
+// Every field is little-endian, fixed-width and naturally aligned so that the Python
+// tracker can fill it with struct.pack_into (see fnvr_pose_pipe.py).
+//
+// Per-slot seqlock protocol for packet number n (1-based):
+//   writer: slot[n % N].sequence = 0, write packet, slot.sequence = n, header.writeSequence = n
+//   reader: n = header.writeSequence, copy slot[n % N], accept only if slot.sequence == n
+//           both before and after the copy (otherwise the writer lapped us: retry)
+//
+// After a packet the writer signals new data - Win32: the auto-reset event named
+// "<mapping>_NewData"; Linux: a futex wake on header.writeSequence - so an idle reader
+// sleeps until then instead of polling. A reader sets readerWaiting before it sleeps;
+// a writer that orders its writeSequence store before reading the flag (a full fence)
+// may skip the signal while the flag is 0. Writers that cannot fence always signal.
+// A quiet writer is not a dead one: the reader only gives up when header.writerPid is
+// cleared (writer closed the ring) or that process no longer exists.
+//
+// Bump SHARED_POSE_RING_VERSION whenever the header or slot layout changes.
+static const uint32_t SHARED_POSE_RING_MAGIC = 0x52564E46;  // "FNVR"
+static const uint32_t SHARED_POSE_RING_VERSION = 3;  // 2: writerPid, readerWaiting; 3: sized slots
+static const uint32_t SHARED_POSE_RING_SLOTS = 16;
+
+struct SharedPoseRingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t slotSize;
+    std::atomic<uint32_t> writeSequence;  // number of the newest complete packet, 0 = none yet
+    std::atomic<uint32_t> writerPid;      // writer's process id; 0 once it has closed the ring
+    std::atomic<uint32_t> readerWaiting;  // 1 while a reader sleeps on the new-data signal
+    uint32_t reserved[9];
+};
+
+struct SharedPoseSlot {
+    std::atomic<uint32_t> sequence;  // packet number stored in this slot, 0 while being written
+    uint32_t packetSize;             // bytes used in packet (V2: 84, V3: 58)
+    unsigned char packet[VR_MAX_WIRE_PACKET_SIZE];  // any supported wire packet
+    uint32_t padding;                // keeps slots 16-byte multiples
+};
+
+struct SharedPoseRing {
+    SharedPoseRingHeader header;
+    SharedPoseSlot slots[SHARED_POSE_RING_SLOTS];
+};
+
+static_assert(sizeof(SharedPoseRingHeader) == 64, "SharedPoseRingHeader layout is shared with the tracker");
+static_assert(sizeof(SharedPoseSlot) == 96, "SharedPoseSlot layout is shared with the tracker");
+
+inline void InitSharedPoseRing(SharedPoseRing* ring, uint32_t writerPid)
+{
+    memset(static_cast<void*>(ring), 0, sizeof(SharedPoseRing));
+    ring->header.writerPid.store(writerPid, std::memory_order_relaxed);
+    ring->header.slotCount = SHARED_POSE_RING_SLOTS;
+    ring->header.slotSize = sizeof(SharedPoseSlot);
+    ring->header.version = SHARED_POSE_RING_VERSION;
+    std::atomic_thread_fence(std::memory_order_release);
+    ring->header.magic = SHARED_POSE_RING_MAGIC;
+}
+
+inline bool IsSharedPoseRingValid(const SharedPoseRing* ring)
+{
+    return ring &&
+        ring->header.magic == SHARED_POSE_RING_MAGIC &&
+        ring->header.version == SHARED_POSE_RING_VERSION &&
+        ring->header.slotCount == SHARED_POSE_RING_SLOTS &&
+        ring->header.slotSize == sizeof(SharedPoseSlot);
+}
+
+// Single writer only. size must not exceed VR_MAX_WIRE_PACKET_SIZE.
+inline void WriteSharedPoseRing(SharedPoseRing* ring, const void* packet, uint32_t size)
+{
+    uint32_t n = ring->header.writeSequence.load(std::memory_order_relaxed) + 1;
+    if (n == 0) n = 1;  // 0 is reserved for "being written"
+
+    SharedPoseSlot& slot = ring->slots[n % SHARED_POSE_RING_SLOTS];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.packetSize = size;
+    memcpy(slot.packet, packet, size);
+    slot.sequence.store(n, std::memory_order_release);
+    ring->header.writeSequence.store(n, std::memory_order_release);
+}
+
+// Copies the newest packet (into a VR_MAX_WIRE_PACKET_SIZE buffer) if it is newer than
+// lastSequence. Never blocks. On success lastSequence is advanced, size receives the
+// packet size and dropped (if given) the number of packets the writer produced since
+// the previous read that were never seen.
+inline bool ReadLatestSharedPose(const SharedPoseRing* ring, uint32_t& lastSequence,
+                                 unsigned char* out, uint32_t& size, uint32_t* dropped = nullptr)
+{
+    for (int attempt = 0; attempt < 4; attempt++) {
+        uint32_t n = ring->header.writeSequence.load(std::memory_order_acquire);
+        if (n == 0 || n == lastSequence) {
+            return false;
+        }
+
+        const SharedPoseSlot& slot = ring->slots[n % SHARED_POSE_RING_SLOTS];
+        if (slot.sequence.load(std::memory_order_acquire) != n) {
+            continue;
+        }
+        size = slot.packetSize;
+        if (size > VR_MAX_WIRE_PACKET_SIZE) {
+            size = VR_MAX_WIRE_PACKET_SIZE;
+        }
+        memcpy(out, slot.packet, size);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != n) {
+            continue;  // Writer lapped the ring while we were copying
+        }
+
+        if (dropped) {
+            *dropped = (lastSequence != 0 && n > lastSequence + 1) ? n - lastSequence - 1 : 0;
+        }
+        lastSequence = n;
+        return true;
+    }
+    return false;
+}
+
+} // namespace FNVR
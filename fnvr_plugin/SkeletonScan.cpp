@@ -0,0 +1,162 @@
+// fnvr_plugin/SkeletonScan.cpp
+#include "SkeletonScan.h"
+#include <cstring>
+
+#ifdef _WIN32
+#include "FRIKSkeleton.h"  // Game headers: only the plugin build has them
+#endif
+
+namespace FNVR {
+
+namespace {
+
+inline char LowerAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+}
+
+bool EqualsNoCase(const char* a, const char* b)
+{
+    while (*a && LowerAscii(*a) == LowerAscii(*b)) {
+        a++;
+        b++;
+    }
+    return LowerAscii(*a) == LowerAscii(*b);
+}
+
+} // namespace
+
+const char* const kFRIKBoneNames[] = {
+    "Bip01", "Bip01 Pelvis",
+    "Bip01 Spine", "Bip01 Spine1", "Bip01 Spine2", nullptr,         // No Spine3 in NV
+    "Bip01 Neck", "Bip01 Neck1", "Bip01 Head",
+
+    "Bip01 L Clavicle", "Bip01 L UpperArm", "Bip01 L Forearm", "Bip01 L Hand",
+    "Bip01 L Finger0", "Bip01 L Finger01", "Bip01 L Finger02",     // Thumb
+    "Bip01 L Finger1", "Bip01 L Finger11", "Bip01 L Finger12",     // Index
+    "Bip01 L Finger2", "Bip01 L Finger21", "Bip01 L Finger22",     // Middle
+    "Bip01 L Finger3", "Bip01 L Finger31", "Bip01 L Finger32",     // Ring
+    "Bip01 L Finger4", "Bip01 L Finger41", "Bip01 L Finger42",     // Pinky
+
+    "Bip01 R Clavicle", "Bip01 R UpperArm", "Bip01 R Forearm", "Bip01 R Hand",
+    "Bip01 R Finger0", "Bip01 R Finger01", "Bip01 R Finger02",
+    "Bip01 R Finger1", "Bip01 R Finger11", "Bip01 R Finger12",
+    "Bip01 R Finger2", "Bip01 R Finger21", "Bip01 R Finger22",
+    "Bip01 R Finger3", "Bip01 R Finger31", "Bip01 R Finger32",
+    "Bip01 R Finger4", "Bip01 R Finger41", "Bip01 R Finger42",
+
+    "Bip01 L Thigh", "Bip01 L Calf", "Bip01 L Foot", "Bip01 L Toe0",
+    "Bip01 R Thigh", "Bip01 R Calf", "Bip01 R Foot", "Bip01 R Toe0",
+
+    "Weapon", "Weapon2", nullptr, nullptr,                          // Holsters: FRIK only
+
+    nullptr, nullptr, nullptr, nullptr,                             // IK targets: FRIK only
+    nullptr, nullptr, nullptr, nullptr
+};
+const int kFRIKBoneCount = sizeof(kFRIKBoneNames) / sizeof(kFRIKBoneNames[0]);
+
+#ifdef _WIN32
+static_assert(sizeof(kFRIKBoneNames) / sizeof(kFRIKBoneNames[0]) == FRIKSkeleton::BONE_COUNT,
+              "kFRIKBoneNames must have one entry per FRIKSkeleton::BoneIndex");
+#endif
+
+BoneNameTable::BoneNameTable() : m_mask(0), m_seed(0), m_count(0), m_named(0), m_internedCount(0)
+{
+    memset(m_table, 0, sizeof(m_table));
+    memset(m_interned, 0, sizeof(m_interned));
+}
+
+uint32_t BoneNameTable::Hash(const char* name, uint32_t seed)
+{
+    // FNV-1a over the lower-cased name, seeded so Build() can search for a collision-free table
+    uint32_t hash = 2166136261u ^ seed;
+    for (; *name; name++) {
+        hash ^= (uint8_t)LowerAscii(*name);
+        hash *= 16777619u;
+    }
+    return hash ^ (hash >> 15);
+}
+
+bool BoneNameTable::TryBuild(const char* const* names, int count, uint32_t size, uint32_t seed)
+{
+    memset(m_table, 0, sizeof(m_table));
+    m_named = 0;
+    for (int i = 0; i < count; i++) {
+        if (!names[i]) {
+            continue;
+        }
+        m_named++;
+        uint32_t hash = Hash(names[i], seed);
+        Entry& entry = m_table[hash & (size - 1)];
+        if (entry.name) {
+            return false;
+        }
+        entry.name = names[i];
+        entry.hash = hash;
+        entry.index = i;
+    }
+    m_mask = size - 1;
+    m_seed = seed;
+    return true;
+}
+
+bool BoneNameTable::Build(const char* const* names, int count)
+{
+    m_count = 0;
+    m_named = 0;
+    m_internedCount = 0;
+    memset(m_interned, 0, sizeof(m_interned));
+    if (count <= 0 || count > kMaxNames) {
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        for (int j = i + 1; j < count && names[i]; j++) {
+            if (names[j] && EqualsNoCase(names[i], names[j])) {
+                return false;  // No seed could ever separate these
+            }
+        }
+    }
+
+    // Sparse table (4-8x the names) so a collision-free seed turns up within a few tries
+    uint32_t size = 4;
+    while (size < (uint32_t)count * 4) {
+        size *= 2;
+    }
+    for (; size <= kMaxTableSize; size *= 2) {
+        for (uint32_t seed = 1; seed <= 4096; seed++) {
+            if (TryBuild(names, count, size, seed)) {
+                m_count = count;
+                return true;
+            }
+        }
+    }
+    memset(m_table, 0, sizeof(m_table));
+    m_named = 0;
+    return false;
+}
+
+void BoneNameTable::SetInterned(int index, const char* handle)
+{
+    if (!handle || index < 0 || index >= m_count || FindInterned(handle) >= 0) {
+        return;
+    }
+    uint32_t slot = InternedSlot(handle);
+    while (m_interned[slot].handle) {
+        slot = (slot + 1) & (kInternedSize - 1);
+    }
+    m_interned[slot].handle = handle;
+    m_interned[slot].index = index;
+    m_internedCount++;
+}
+
+int BoneNameTable::Find(const char* name) const
+{
+    uint32_t hash = Hash(name, m_seed);
+    const Entry& entry = m_table[hash & m_mask];
+    if (entry.hash != hash || !entry.name || !EqualsNoCase(entry.name, name)) {
+        return -1;
+    }
+    return entry.index;
+}
+
+} // namespace FNVR
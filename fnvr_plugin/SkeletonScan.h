@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstdint>
+
+// One-pass lookup of a whole set of bones in a node tree.
+//
+// BoneNameTable is a case-insensitive perfect hash over a fixed set of bone names
+// (NVCSSkeleton::NVCSBone, FRIKSkeleton::BoneIndex, ...): every wanted name has a
+// bucket of its own, so testing a node costs one hash of its name, one integer compare
+// and - only on a hash hit - one string compare. ScanSkeleton walks the tree once and
+// fills a node pointer per wanted bone, instead of a full search per bone.
+//
+// When the engine interns node names (Gamebryo NiFixedString: one shared copy per
+// distinct string), SetInterned() registers each wanted name's shared pointer and the
+// scan first matches by pointer alone, falling back to the case-insensitive hash only
+// for bones that did not turn up that way.
+//
+// Independent of the game headers, so it builds and benchmarks anywhere; the node
+// type is reached through a traits class:
+//
+//   struct Traits {
+//       static const char* Name(Node* node);            // may be nullptr
+//       static uint32_t ChildCount(Node* node);
+//       static Node* Child(Node* node, uint32_t i);     // nullptr: skip (leaf geometry etc.)
+//   };
+
+namespace FNVR {
+
+class BoneNameTable
+{
+public:
+    static const int kMaxNames = 128;
+
+    BoneNameTable();
+
+    // names[i] is the bone for index i; nullptr entries are never matched. The strings
+    // are not copied. False if there are too many names or two compare equal.
+    bool Build(const char* const* names, int count);
+
+    bool IsBuilt() const { return m_count > 0; }
+    int GetCount() const { return m_count; }
+    int GetNamedCount() const { return m_named; }  // Entries with a name
+
+    // Index of the bone called name (any case), or -1
+    int Find(const char* name) const;
+
+    // Interned copy of entry index's name, matched by address. Call after Build().
+    void SetInterned(int index, const char* handle);
+    bool HasInterned() const { return m_internedCount > 0; }
+
+    // Index of the bone whose interned name is exactly this pointer, or -1. Never
+    // reads the string.
+    int FindInterned(const char* name) const
+    {
+        uint32_t slot = InternedSlot(name);
+        while (m_interned[slot].handle) {
+            if (m_interned[slot].handle == name) {
+                return m_interned[slot].index;
+            }
+            slot = (slot + 1) & (kInternedSize - 1);
+        }
+        return -1;
+    }
+
+private:
+    struct Entry {
+        const char* name;
+        uint32_t hash;
+        int index;
+    };
+
+    struct InternedEntry {
+        const char* handle;
+        int index;
+    };
+
+    static uint32_t Hash(const char* name, uint32_t seed);
+    static uint32_t InternedSlot(const char* handle)
+    {
+        // Fibonacci hash of the address; allocations are 8-aligned, so drop those bits
+        return (uint32_t)(((uintptr_t)handle >> 3) * 2654435761u) >> (32 - kInternedBits);
+    }
+    bool TryBuild(const char* const* names, int count, uint32_t size, uint32_t seed);
+
+    static const uint32_t kMaxTableSize = 1024;
+    static const uint32_t kInternedBits = 9;
+    static const uint32_t kInternedSize = 1 << kInternedBits;  // >= 4x kMaxNames: short probes
+
+    Entry m_table[kMaxTableSize];
+    InternedEntry m_interned[kInternedSize];
+    uint32_t m_mask;
+    uint32_t m_seed;
+    int m_count;
+    int m_named;
+    int m_internedCount;
+};
+
+// Bone names in FRIKSkeleton::BoneIndex order, kFRIKBoneCount (== BONE_COUNT) entries.
+// nullptr for FRIK-only bones (IK targets, holsters, ...) that have no node in the
+// vanilla/NVCS skeleton. Keep in step with the enum in FRIKSkeleton.h.
+extern const char* const kFRIKBoneNames[];
+extern const int kFRIKBoneCount;
+
+template <class Traits, class Node>
+void ScanSkeletonNode(Node* node, const BoneNameTable& table, bool byPointer, Node** out, int& remaining)
+{
+    const char* name = Traits::Name(node);
+    if (name) {
+        int index = byPointer ? table.FindInterned(name) : table.Find(name);
+        if (index >= 0 && !out[index]) {
+            out[index] = node;  // First match in depth-first order, as a per-name search would find
+            remaining--;
+        }
+    }
+
+    uint32_t count = Traits::ChildCount(node);
+    for (uint32_t i = 0; i < count && remaining > 0; i++) {
+        Node* child = Traits::Child(node, i);
+        if (child) {
+            ScanSkeletonNode<Traits>(child, table, byPointer, out, remaining);
+        }
+    }
+}
+
+// Fills out[0 .. table.GetCount()) with the matching nodes (nullptr where absent) and
+// returns how many were found. Stops early once every bone has been found.
+//
+// With interned names the pointer pass runs first; the case-insensitive pass follows
+// only if bones are still missing and fewer than expectedFound were found (a skeleton
+// known to hold that many, e.g. from the last full scan). expectedFound < 0: whenever
+// bones are missing.
+template <class Traits, class Node>
+int ScanSkeleton(Node* root, const BoneNameTable& table, Node** out, int expectedFound = -1)
+{
+    int count = table.GetCount();
+    for (int i = 0; i < count; i++) {
+        out[i] = nullptr;
+    }
+    if (!root) {
+        return 0;
+    }
+
+    const int wanted = table.GetNamedCount();
+    int remaining = wanted;
+    if (table.HasInterned()) {
+        ScanSkeletonNode<Traits>(root, table, true, out, remaining);
+        if (remaining == 0 || (expectedFound >= 0 && wanted - remaining >= expectedFound)) {
+            return wanted - remaining;
+        }
+    }
+    ScanSkeletonNode<Traits>(root, table, false, out, remaining);
+    return wanted - remaining;
+}
+
+} // namespace FNVR
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "VRPacketView.h"
+#include "SessionRecording.h"
+
+// Common interface of every pose transport consumed by PipeThreadFunc:
+//   PipeClient           - named pipe (Win32 only)
+//   SharedMemoryClient   - shared-memory seqlock ring
+//   UdpTrackingSource    - loopback UDP datagrams
+//   ReplayTrackingSource - recorded packet stream from disk
+//
+// Everything except PipeClient builds on POSIX too, so the decode -> validate ->
+// publish path can be driven and profiled outside the game.
+class ITrackingSource
+{
+public:
+    ITrackingSource() : m_stopFlag(nullptr), m_recorder(nullptr) {}
+    virtual ~ITrackingSource() {}
+
+    virtual bool Connect() = 0;
+    virtual void Disconnect() = 0;
+    virtual bool IsConnected() const = 0;
+
+    // Waits for the next sample and stores the raw wire packet (already checked to be
+    // a complete packet of a known version). Returns false when the source was lost
+    // or a stop was requested; the caller then reconnects.
+    virtual bool Read(WirePacket& packet) = 0;
+
+    // Samples the source skipped to stay on the newest one (latest-wins reads)
+    virtual uint32_t GetDroppedPackets() const { return 0; }
+
+    virtual const char* GetName() const = 0;
+
+    // Flag polled while waiting for new samples; Read() returns false once it is set
+    void SetStopFlag(const std::atomic<bool>* stopFlag) { m_stopFlag = stopFlag; }
+
+    // Optional capture of every raw wire packet received, including ones later
+    // skipped by latest-wins reads (owned by the caller, used on the reading thread)
+    void SetRecorder(FNVR::SessionRecorder* recorder) { m_recorder = recorder; }
+
+protected:
+    bool IsStopRequested() const { return m_stopFlag && m_stopFlag->load(std::memory_order_relaxed); }
+
+    void RecordPacket(const void* packet, uint32_t size) {
+        if (m_recorder) {
+            m_recorder->Record(packet, size);
+        }
+    }
+
+    const std::atomic<bool>* m_stopFlag;
+    FNVR::SessionRecorder* m_recorder;
+};
+
+// Sanity check applied to every sample before it is published.
+// hmdQuatLengthSq (optional) receives the squared HMD quaternion length.
+inline bool IsTrackingPacketValid(const VRPacketView& packet, float* hmdQuatLengthSq = nullptr)
+{
+    if (!packet.IsValid()) {
+        return false;
+    }
+    const VRPose& hmd = packet.Hmd();
+    float lengthSq = hmd.qw*hmd.qw + hmd.qx*hmd.qx + hmd.qy*hmd.qy + hmd.qz*hmd.qz;
+    if (hmdQuatLengthSq) {
+        *hmdQuatLengthSq = lengthSq;
+    }
+    return lengthSq >= 0.9f && lengthSq <= 1.1f;
+}
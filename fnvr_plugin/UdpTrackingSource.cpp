@@ -0,0 +1,226 @@
+// fnvr_plugin/UdpTrackingSource.cpp
+#include "UdpTrackingSource.h"
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// Basit log makrosu
+#ifndef _MESSAGE
+#define _MESSAGE(fmt, ...) ((void)0)
+#endif
+
+namespace {
+
+const intptr_t kInvalidSocket = -1;
+
+void CloseSocket(intptr_t s)
+{
+#ifdef _WIN32
+    closesocket((SOCKET)s);
+#else
+    close((int)s);
+#endif
+}
+
+bool SetNonBlocking(intptr_t s)
+{
+#ifdef _WIN32
+    u_long enabled = 1;
+    return ioctlsocket((SOCKET)s, FIONBIO, &enabled) == 0;
+#else
+    int flags = fcntl((int)s, F_GETFL, 0);
+    return flags >= 0 && fcntl((int)s, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+bool WouldBlock()
+{
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+} // namespace
+
+UdpTrackingSource::UdpTrackingSource(uint16_t port)
+    : m_port(port), m_socket(kInvalidSocket), m_droppedPackets(0), m_socketApiStarted(false) {}
+
+UdpTrackingSource::~UdpTrackingSource()
+{
+    Disconnect();
+#ifdef _WIN32
+    if (m_socketApiStarted) {
+        WSACleanup();
+    }
+#endif
+}
+
+bool UdpTrackingSource::Connect()
+{
+    if (m_socket != kInvalidSocket) {
+        return true;
+    }
+
+#ifdef _WIN32
+    if (!m_socketApiStarted) {
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+            return false;
+        }
+        m_socketApiStarted = true;
+    }
+    SOCKET s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == INVALID_SOCKET) {
+        return false;
+    }
+    intptr_t handle = (intptr_t)s;
+#else
+    int s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s < 0) {
+        return false;
+    }
+    intptr_t handle = s;
+#endif
+
+    // Loopback only: poses are never accepted from the network
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(m_port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(s, (const sockaddr*)&addr, sizeof(addr)) != 0 || !SetNonBlocking(handle)) {
+        _MESSAGE("FNVR | Could not bind UDP port %u", (unsigned)m_port);
+        CloseSocket(handle);
+        return false;
+    }
+
+    m_socket = handle;
+    _MESSAGE("FNVR | Listening for poses on udp://127.0.0.1:%u", (unsigned)m_port);
+    return true;
+}
+
+void UdpTrackingSource::Disconnect()
+{
+    if (m_socket != kInvalidSocket) {
+        CloseSocket(m_socket);
+        m_socket = kInvalidSocket;
+        _MESSAGE("FNVR | UDP tracking source closed.");
+    }
+}
+
+bool UdpTrackingSource::IsConnected() const
+{
+    return m_socket != kInvalidSocket;
+}
+
+// Returns the datagram size, 0 if nothing arrived (or a stop was requested while
+// waiting) and -1 on socket errors.
+int UdpTrackingSource::ReceiveDatagram(unsigned char* buffer, bool wait)
+{
+    while (true) {
+#ifdef _WIN32
+        int received = recv((SOCKET)m_socket, (char*)buffer, VR_MAX_WIRE_PACKET_SIZE, 0);
+        if (received == SOCKET_ERROR && WSAGetLastError() == WSAEMSGSIZE) {
+            continue;  // Oversized datagram: not one of ours, skip it
+        }
+#else
+        int received = (int)recv((int)m_socket, buffer, VR_MAX_WIRE_PACKET_SIZE, MSG_TRUNC);
+        if (received > (int)VR_MAX_WIRE_PACKET_SIZE) {
+            continue;
+        }
+#endif
+        if (received >= 0) {
+            return received;
+        }
+        if (!WouldBlock()) {
+            return -1;
+        }
+        if (!wait) {
+            return 0;
+        }
+
+        // Nothing queued: sleep in the kernel until data arrives or it is time to check the stop flag
+        do {
+            if (IsStopRequested()) {
+                return 0;
+            }
+            fd_set readSet;
+            FD_ZERO(&readSet);
+#ifdef _WIN32
+            FD_SET((SOCKET)m_socket, &readSet);
+#else
+            FD_SET((int)m_socket, &readSet);
+#endif
+            timeval timeout = { 0, kPollIntervalMs * 1000 };
+            int ready = select((int)m_socket + 1, &readSet, NULL, NULL, &timeout);
+            if (ready < 0) {
+                return -1;
+            }
+            if (ready > 0) {
+                break;
+            }
+        } while (true);
+    }
+}
+
+bool UdpTrackingSource::Read(WirePacket& packet)
+{
+    if (m_socket == kInvalidSocket) {
+        return false;
+    }
+
+    while (true) {
+        int size = ReceiveDatagram(packet.data, true);
+        if (size < 0 || IsStopRequested()) {
+            return false;
+        }
+        if (size == 0) {
+            continue;
+        }
+        RecordPacket(packet.data, (uint32_t)size);
+        bool valid = AcceptDatagram(packet.data, size);
+
+        // Latest wins: swallow everything queued behind the first datagram, keeping the
+        // newest valid one - a stray datagram never displaces a good packet
+        int next;
+        while ((next = ReceiveDatagram(m_scratch, false)) > 0) {
+            RecordPacket(m_scratch, (uint32_t)next);
+            if (!AcceptDatagram(m_scratch, next)) {
+                continue;
+            }
+            if (valid) {
+                m_droppedPackets++;
+            }
+            memcpy(packet.data, m_scratch, next);
+            size = next;
+            valid = true;
+        }
+
+        if (valid) {
+            packet.size = (uint32_t)size;
+            return true;
+        }
+    }
+}
+
+bool UdpTrackingSource::AcceptDatagram(const unsigned char* data, int size)
+{
+    if (IsWirePacketValid(data, (uint32_t)size)) {
+        return true;
+    }
+    // Stray datagram on our port; keep listening rather than rebinding
+    _MESSAGE("FNVR | Warning: Ignoring UDP datagram (version %u, %d bytes)", GetWirePacketVersion(data), size);
+    return false;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include "TrackingSource.h"
+
+// Loopback UDP tracking source: one V2 or V3 wire packet per datagram, sent by
+// fnvr_pose_pipe.py --udp to 127.0.0.1:port. Datagrams queued behind a newer one
+// are skipped (latest wins) and counted as dropped; datagrams that are not a valid
+// wire packet are logged and ignored.
+//
+// Backends: Winsock and BSD sockets.
+class UdpTrackingSource : public ITrackingSource
+{
+public:
+    UdpTrackingSource(uint16_t port);
+    ~UdpTrackingSource();
+
+    bool Connect() override;       // Binds the socket; UDP has no peer to wait for
+    void Disconnect() override;
+    bool IsConnected() const override;
+    bool Read(WirePacket& packet) override;
+    uint32_t GetDroppedPackets() const override { return m_droppedPackets; }
+    const char* GetName() const override { return "loopback UDP"; }
+
+    static const uint16_t kDefaultPort = 49152;
+    static const int kPollIntervalMs = 100;  // How often a blocked Read() checks the stop flag
+
+private:
+    int ReceiveDatagram(unsigned char* buffer, bool wait);
+    bool AcceptDatagram(const unsigned char* data, int size);  // Valid wire packet; logs the rest
+
+    uint16_t m_port;
+    intptr_t m_socket;  // SOCKET on Windows, fd on POSIX; -1 when closed
+    uint32_t m_droppedPackets;
+    bool m_socketApiStarted;
+    unsigned char m_scratch[VR_MAX_WIRE_PACKET_SIZE];  // Datagrams queued behind the first one
+};
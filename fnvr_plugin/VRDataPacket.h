@@ -1,10 +1,48 @@
 #pragma once
 
 // This file just includes the actual packet definitions from FNVRGlobals
-// The VRDataPacketV2 is the wire format (what Python sends)
-// The VRDataPacketFlat/VRDataPacket is the game format (what the plugin uses internally)
+// The VRDataPacketV2/V3 structs are the wire formats (what Python sends)
+// The VRDataPacketFlat/VRDataPacket is the decoded format for off-game tools and
+// encoders; the plugin itself reads received packets in place via VRPacketView.h
 
 #include "../FNVRGlobals/VRDataPacketV2.h"
+#include "../FNVRGlobals/VRDataPacketV3.h"
 
 // VRDataPacket is now defined in VRDataPacketV2.h as VRDataPacketFlat
-// ConvertV2ToFull is also defined there as ConvertV2ToFlat
\ No newline at end of file
+// ConvertV2ToFull is also defined there as ConvertV2ToFlat
+
+// Largest wire packet any transport has to buffer
+static const unsigned int VR_MAX_WIRE_PACKET_SIZE = sizeof(VRDataPacketV2);
+
+// Wire version from the first bytes of a packet. V2 starts with a uint32 version,
+// V3 with a uint16, so the low 16 bits (little-endian) identify both.
+inline unsigned int GetWirePacketVersion(const void* data)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    return bytes[0] | (bytes[1] << 8);
+}
+
+// Size of a wire packet of the given version, 0 if unknown
+inline unsigned int GetWirePacketSize(unsigned int version)
+{
+    switch (version) {
+        case 2: return sizeof(VRDataPacketV2);
+        case 3: return sizeof(VRDataPacketV3);
+        default: return 0;
+    }
+}
+
+// Decode any supported wire packet into the game format
+inline bool DecodeWirePacket(const void* data, unsigned int size, VRDataPacketFlat& out)
+{
+    unsigned int version = GetWirePacketVersion(data);
+    if (size != GetWirePacketSize(version)) {
+        return false;
+    }
+    if (version == 3) {
+        ConvertV3ToFlat(*static_cast<const VRDataPacketV3*>(data), out);
+    } else {
+        ConvertV2ToFlat(*static_cast<const VRDataPacketV2*>(data), out);
+    }
+    return true;
+}
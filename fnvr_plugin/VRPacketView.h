@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include "VRDataPacket.h"
+
+// Raw wire packet as received from a tracking source. This is what the pose
+// mailbox carries: sources read straight into it and consumers look at it through
+// VRPacketView, so a V2 sample is never converted or copied field by field.
+struct WirePacket
+{
+    uint32_t size;  // Bytes used in data; 0 = empty
+    unsigned char data[VR_MAX_WIRE_PACKET_SIZE];
+};
+
+// One tracked device: orientation (w, x, y, z) then position in metres (OpenVR space).
+// Same order and packing as the V2 wire fields, so a V2 pose is viewed in place.
+#pragma pack(push, 1)
+struct VRPose
+{
+    float qw, qx, qy, qz;
+    float px, py, pz;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(VRPose) == 28, "VRPose overlays VRDataPacketV2 pose fields");
+
+// Is data a complete packet of a version we understand?
+inline bool IsWirePacketValid(const void* data, unsigned int size)
+{
+    return size >= 2 && size == GetWirePacketSize(GetWirePacketVersion(data));
+}
+
+// Read-only typed access to a WirePacket.
+//
+// V2: every accessor reads the wire bytes directly (poses are references into the
+//     packet). V2 has no left controller and no inputs.
+// V3: the three poses are dequantized once when the view is made; everything else
+//     is read from the wire bytes.
+// Devices a packet does not carry report HasDevice() == false and an identity pose
+// at the origin. The view is only valid while the underlying WirePacket is.
+class VRPacketView
+{
+public:
+    explicit VRPacketView(const WirePacket& packet)
+        : m_data(packet.data), m_version(0)
+    {
+        if (!IsWirePacketValid(packet.data, packet.size)) {
+            return;
+        }
+        m_version = GetWirePacketVersion(packet.data);
+        if (m_version == 3) {
+            const VRDataPacketV3& v3 = AsV3();
+            DecodeV3Pose(v3.hmd, v3.quatLargest, 0, m_poses[0]);
+            DecodeV3Pose(v3.left, v3.quatLargest, 1, m_poses[1]);
+            DecodeV3Pose(v3.right, v3.quatLargest, 2, m_poses[2]);
+        }
+    }
+
+    bool IsValid() const { return m_version != 0; }
+    unsigned int GetVersion() const { return m_version; }
+
+    double GetTimestamp() const {
+        return m_version == 3 ? AsV3().timestamp : AsV2().timestamp;
+    }
+
+    // Timestamp clock: time.perf_counter() when true, time.time() otherwise (see ClockSync)
+    bool HasMonotonicTimestamp() const {
+        return m_version == 3 ? (AsV3().deviceMask & VR3_FLAG_MONOTONIC_TIME) != 0
+                              : (AsV2().flags & VR_FLAG_MONOTONIC_TIME) != 0;
+    }
+
+    bool HasDevice(unsigned int deviceBit) const {
+        return m_version == 3 ? (AsV3().deviceMask & deviceBit) != 0
+                              : (deviceBit & (VR3_DEVICE_HMD | VR3_DEVICE_RIGHT)) != 0;
+    }
+
+    const VRPose& Hmd() const {
+        return m_version == 3 ? m_poses[0] : *reinterpret_cast<const VRPose*>(&AsV2().hmd_qw);
+    }
+    const VRPose& Right() const {
+        return m_version == 3 ? m_poses[2] : *reinterpret_cast<const VRPose*>(&AsV2().ctl_qw);
+    }
+    const VRPose& Left() const {
+        return m_version == 3 ? m_poses[1] : IdentityPose();
+    }
+
+    // Inputs (V3 only; V2 reports everything released). hand: 0 = left, 1 = right
+    unsigned int GetButtons() const { return m_version == 3 ? AsV3().buttons : 0; }
+    float GetTrigger(int hand) const { return m_version == 3 ? AsV3().trigger[hand] * (1.0f / 255.0f) : 0.0f; }
+    float GetGrip(int hand) const { return m_version == 3 ? AsV3().grip[hand] * (1.0f / 255.0f) : 0.0f; }
+    float GetPadX(int hand) const { return m_version == 3 ? AsV3().pad_x[hand] * (1.0f / 127.0f) : 0.0f; }
+    float GetPadY(int hand) const { return m_version == 3 ? AsV3().pad_y[hand] * (1.0f / 127.0f) : 0.0f; }
+
+private:
+    const VRDataPacketV2& AsV2() const { return *reinterpret_cast<const VRDataPacketV2*>(m_data); }
+    const VRDataPacketV3& AsV3() const { return *reinterpret_cast<const VRDataPacketV3*>(m_data); }
+
+    static const VRPose& IdentityPose() {
+        static const VRPose identity = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+        return identity;
+    }
+
+    void DecodeV3Pose(const VR3DevicePose& pose, unsigned char quatLargest, unsigned int device, VRPose& out) const {
+        static const unsigned int deviceBits[3] = { VR3_DEVICE_HMD, VR3_DEVICE_LEFT, VR3_DEVICE_RIGHT };
+        if (!(AsV3().deviceMask & deviceBits[device])) {
+            out = IdentityPose();
+            return;
+        }
+        float q[4], p[3];
+        VR3DecodePose(pose, quatLargest, device, q, p);
+        out.qw = q[0]; out.qx = q[1]; out.qy = q[2]; out.qz = q[3];
+        out.px = p[0]; out.py = p[1]; out.pz = p[2];
+    }
+
+    const unsigned char* m_data;
+    unsigned int m_version;
+    VRPose m_poses[3];  // V3 only: hmd, left, right
+};
@@ -1,5 +1,6 @@
 #include "internal/prefix.h"  // JIP-LN SDK prefix - temel tipler için
 #include "VRSystem.h"
+#include "CoordinateFrames.h"
 #include <fstream>
 #include <cmath>
 
@@ -18,9 +19,9 @@ static const float RAD2DEG = 180.0f / PI;
 // Matrix işlemleri
 HmdVector3_t VRManager::TransformPoint(const HmdVector3_t& point, const HmdMatrix34_t& matrix) {
     HmdVector3_t result;
-    result.v[0] = matrix.m[0][0] * point.v[0] + matrix.m[0][1] * point.v[1] + matrix.m[0][2] * point.v[2] + matrix.m[0][3];
-    result.v[1] = matrix.m[1][0] * point.v[0] + matrix.m[1][1] * point.v[1] + matrix.m[1][2] * point.v[2] + matrix.m[1][3];
-    result.v[2] = matrix.m[2][0] * point.v[0] + matrix.m[2][1] * point.v[1] + matrix.m[2][2] * point.v[2] + matrix.m[2][3];
+    MatrixRows rows;
+    LoadRows34(&matrix.m[0][0], rows);
+    FNVR::TransformPoint(rows, point.v, result.v);
     return result;
 }
 
@@ -60,94 +61,41 @@ HmdQuaternionf_t VRManager::MatrixToQuaternion(const HmdMatrix34_t& matrix) {
 
 HmdMatrix34_t VRManager::QuaternionToMatrix(const HmdQuaternionf_t& q) {
     HmdMatrix34_t matrix;
-    
-    float xx = q.x * q.x;
-    float yy = q.y * q.y;
-    float zz = q.z * q.z;
-    float xy = q.x * q.y;
-    float xz = q.x * q.z;
-    float yz = q.y * q.z;
-    float wx = q.w * q.x;
-    float wy = q.w * q.y;
-    float wz = q.w * q.z;
-    
-    matrix.m[0][0] = 1.0f - 2.0f * (yy + zz);
-    matrix.m[0][1] = 2.0f * (xy - wz);
-    matrix.m[0][2] = 2.0f * (xz + wy);
-    matrix.m[0][3] = 0.0f;
-    
-    matrix.m[1][0] = 2.0f * (xy + wz);
-    matrix.m[1][1] = 1.0f - 2.0f * (xx + zz);
-    matrix.m[1][2] = 2.0f * (yz - wx);
-    matrix.m[1][3] = 0.0f;
-    
-    matrix.m[2][0] = 2.0f * (xz - wy);
-    matrix.m[2][1] = 2.0f * (yz + wx);
-    matrix.m[2][2] = 1.0f - 2.0f * (xx + yy);
-    matrix.m[2][3] = 0.0f;
-    
+    MatrixRows rows;
+    QuatToRows(LoadQuat(&q.w), rows);
+    StoreRows34(&matrix.m[0][0], rows);
     return matrix;
 }
 
 HmdMatrix34_t VRManager::MultiplyMatrices(const HmdMatrix34_t& a, const HmdMatrix34_t& b) {
     HmdMatrix34_t result;
-    
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 4; j++) {
-            result.m[i][j] = 0.0f;
-            for (int k = 0; k < 3; k++) {
-                result.m[i][j] += a.m[i][k] * b.m[k][j];
-            }
-            if (j == 3) {
-                result.m[i][j] += a.m[i][3];
-            }
-        }
-    }
-    
+    MatrixRows rowsA, rowsB;
+    LoadRows34(&a.m[0][0], rowsA);
+    LoadRows34(&b.m[0][0], rowsB);
+    ComposeRows(rowsA, rowsB, rowsA);
+    StoreRows34(&result.m[0][0], rowsA);
     return result;
 }
 
-// Coordinate system conversions
+// Coordinate system conversions (CoordinateFrames.h)
 void VRManager::ConvertOpenVRToGamebryo(const HmdVector3_t& vrPos, HmdVector3_t& gamePos, float scale) {
-    // OpenVR: Right-handed, +Y up, +X right, -Z forward (meters)
-    // Gamebryo: Left-handed, +Z up, +X right, +Y forward (game units)
-    // Verified from Gemini analysis and community testing
-    
-    gamePos.v[0] =  vrPos.v[0] * scale;  // X -> X (right stays right)
-    gamePos.v[1] = -vrPos.v[2] * scale;  // -Z -> Y (forward)
-    gamePos.v[2] =  vrPos.v[1] * scale;  // Y -> Z (up)
+    // OpenVR: +Y up, +X right, -Z forward (meters)
+    // Gamebryo: +Z up, +X right, +Y forward (game units); both right-handed
+    OpenVRToGamebryoAxes::Position(vrPos.v, gamePos.v, scale);
 }
 
 void VRManager::ConvertGamebryoToOpenVR(const HmdVector3_t& gamePos, HmdVector3_t& vrPos, float scale) {
     // Inverse transformation (rarely needed)
     if (scale != 0.0f) {
-        vrPos.v[0] =  gamePos.v[0] / scale;  // X -> X
-        vrPos.v[1] =  gamePos.v[2] / scale;  // Z -> Y
-        vrPos.v[2] = -gamePos.v[1] / scale;  // Y -> -Z
+        GamebryoAxesToOpenVR::Position(gamePos.v, vrPos.v, 1.0f / scale);
     }
 }
 
 // Quaternion conversion for rotations
 void VRManager::ConvertOpenVRQuaternionToGamebryo(const HmdQuaternion_t& vrQuat, HmdQuaternion_t& gameQuat) {
-    // OpenVR to Gamebryo requires a -90 degree rotation around X axis
-    // This is equivalent to pre-multiplying by quaternion (0.7071, -0.7071, 0, 0)
-    const float r_sqrt2_inv = 0.7071067811865476f; // 1/sqrt(2)
-    
-    gameQuat.w = (vrQuat.w + vrQuat.x) * r_sqrt2_inv;
-    gameQuat.x = (vrQuat.x - vrQuat.w) * r_sqrt2_inv;
-    gameQuat.y = (vrQuat.y + vrQuat.z) * r_sqrt2_inv;
-    gameQuat.z = (vrQuat.z - vrQuat.y) * r_sqrt2_inv;
-    
-    // Normalize to prevent drift
-    float mag = sqrtf(gameQuat.w*gameQuat.w + gameQuat.x*gameQuat.x + 
-                     gameQuat.y*gameQuat.y + gameQuat.z*gameQuat.z);
-    if (mag > 0.0f) {
-        float invMag = 1.0f / mag;
-        gameQuat.w *= invMag;
-        gameQuat.x *= invMag;
-        gameQuat.y *= invMag;
-        gameQuat.z *= invMag;
-    }
+    // Bone-space mapping: pre-multiplied by a constant unit quaternion, so the
+    // norm is carried through unchanged
+    StoreQuat(&gameQuat.w, QuatMultiply(OpenVRToGamebryoQuat(), LoadQuat(&vrQuat.w)));
 }
 
 // VRManager implementasyonu
@@ -199,9 +147,44 @@ void VRManager::LoadConfig(const std::string& path) {
     config.weapon.adsOffsetY = readFloat("Weapon", "ADSOffsetY", -1.0f);
     config.weapon.adsOffsetZ = readFloat("Weapon", "ADSOffsetZ", -3.0f);
     
+    BakeCalibration();
     _MESSAGE("FNVR | Config loaded successfully");
 }
 
+// Folds the right hand's position config into one affine, and the weapon offsets and
+// grip angles into ready-made transforms, so per frame there is no trigonometry left.
+// Only what Update() and GetWeaponTransform() read is baked: the HMD and left hand
+// configs and the rotation offsets have no consumer here.
+void VRManager::BakeCalibration() {
+    // Right hand position: OpenVR meters -> game units (70/m), times its scale, plus offsets
+    MatrixRows toGame;
+    OpenVRToGamebryo::Rows(config.rightPosition.scale, toGame);
+    baked.right.SetIdentity();
+    baked.right.AppendTransform(toGame);
+    baked.right.AppendOffset(config.rightPosition.offsetX, config.rightPosition.offsetY, config.rightPosition.offsetZ);
+    
+    // Weapon: grip angles after the grip or ADS offset
+    HmdQuaternionf_t gripRotation;
+    StoreQuat(&gripRotation.w, QuatFromEulerDegrees(config.weapon.gripPitch, config.weapon.gripYaw, config.weapon.gripRoll));
+    HmdMatrix34_t rotMatrix = QuaternionToMatrix(gripRotation);
+    
+    const float offsets[2][3] = {
+        {config.weapon.gripOffsetX, config.weapon.gripOffsetY, config.weapon.gripOffsetZ},
+        {config.weapon.adsOffsetX, config.weapon.adsOffsetY, config.weapon.adsOffsetZ}
+    };
+    HmdMatrix34_t* targets[2] = {&baked.weaponGrip, &baked.weaponAds};
+    for (int t = 0; t < 2; t++) {
+        HmdMatrix34_t transform;
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                transform.m[i][j] = (i == j) ? 1.0f : 0.0f;
+            }
+            transform.m[i][3] = offsets[t][i];
+        }
+        *targets[t] = MultiplyMatrices(transform, rotMatrix);
+    }
+}
+
 void VRManager::SaveConfig(const std::string& path) {
     // INI dosyasına yazma
     auto writeFloat = [&](const char* section, const char* key, float value) {
@@ -239,11 +222,14 @@ void VRManager::Update(const VRDataPacket& packet) {
     HmdVector3_t rightPosGame;
     ConvertOpenVRToGamebryo(rightPosVR, rightPosGame);
     
-    // Relative pozisyon hesapla (Bethesda tarzı)
+    // Relative pozisyon hesapla (Bethesda tarzı): baked right-hand chain on the HMD -> controller offset
+    const float rightFromHmd[3] = {
+        packet.rightController.px - packet.hmd.px,
+        packet.rightController.py - packet.hmd.py,
+        packet.rightController.pz - packet.hmd.pz
+    };
     HmdVector3_t relativePos;
-    relativePos.v[0] = (rightPosGame.v[0] - hmdPosGame.v[0]) * config.rightPosition.scale + config.rightPosition.offsetX;
-    relativePos.v[1] = (rightPosGame.v[1] - hmdPosGame.v[1]) * config.rightPosition.scale + config.rightPosition.offsetY;
-    relativePos.v[2] = (rightPosGame.v[2] - hmdPosGame.v[2]) * config.rightPosition.scale + config.rightPosition.offsetZ;
+    baked.right.TransformPosition(rightFromHmd, relativePos.v);
     
     // Silah transformunu hesapla
     HmdMatrix34_t weaponTransform = GetWeaponTransform(false);
@@ -280,49 +266,8 @@ void VRManager::Update(const VRDataPacket& packet) {
 }
 
 HmdMatrix34_t VRManager::GetWeaponTransform(bool isAiming) {
-    HmdMatrix34_t transform;
-    
-    // Identity matrix başlat
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 4; j++) {
-            transform.m[i][j] = (i == j) ? 1.0f : 0.0f;
-        }
-    }
-    
-    // Silah offset'lerini uygula
-    if (isAiming) {
-        transform.m[0][3] = config.weapon.adsOffsetX;
-        transform.m[1][3] = config.weapon.adsOffsetY;
-        transform.m[2][3] = config.weapon.adsOffsetZ;
-    } else {
-        transform.m[0][3] = config.weapon.gripOffsetX;
-        transform.m[1][3] = config.weapon.gripOffsetY;
-        transform.m[2][3] = config.weapon.gripOffsetZ;
-    }
-    
-    // Rotasyon uygula
-    HmdQuaternionf_t rotation;
-    float pitchRad = config.weapon.gripPitch * DEG2RAD;
-    float yawRad = config.weapon.gripYaw * DEG2RAD;
-    float rollRad = config.weapon.gripRoll * DEG2RAD;
-    
-    // Euler'dan quaternion'a dönüşüm
-    float cy = cosf(yawRad * 0.5f);
-    float sy = sinf(yawRad * 0.5f);
-    float cp = cosf(pitchRad * 0.5f);
-    float sp = sinf(pitchRad * 0.5f);
-    float cr = cosf(rollRad * 0.5f);
-    float sr = sinf(rollRad * 0.5f);
-    
-    rotation.w = cr * cp * cy + sr * sp * sy;
-    rotation.x = sr * cp * cy - cr * sp * sy;
-    rotation.y = cr * sp * cy + sr * cp * sy;
-    rotation.z = cr * cp * sy - sr * sp * cy;
-    
-    HmdMatrix34_t rotMatrix = QuaternionToMatrix(rotation);
-    transform = MultiplyMatrices(transform, rotMatrix);
-    
-    return transform;
+    // Baked from the config (BakeCalibration)
+    return isAiming ? baked.weaponAds : baked.weaponGrip;
 }
 
 void VRManager::CalculateArmIK(const HmdVector3_t& shoulderPos, const HmdVector3_t& handPos, 
@@ -401,6 +346,7 @@ void VRManager::FinishCalibration() {
     config.armLength = config.playerHeight * 0.37f;  // Ortalama oran
     
     isCalibrated = true;
+    BakeCalibration();
     _MESSAGE("FNVR | Calibration complete. Player height: %.2fm, Arm length: %.2fm", 
              config.playerHeight, config.armLength);
     
@@ -1,5 +1,6 @@
 #pragma once
 #include "Globals.h"
+#include "DeviceCalibration.h"
 #include <vector>
 #include <string>
 
@@ -96,6 +97,13 @@ private:
         HmdMatrix34_t leftCalibrationPose;
     } calibration;
 
+    // Config folded into ready transforms by BakeCalibration()
+    struct BakedCalibration {
+        DeviceCalibration right;  // Position chain only: Update()'s relative hand position
+        HmdMatrix34_t weaponGrip;
+        HmdMatrix34_t weaponAds;
+    } baked;
+
     // IK hesaplamaları için
     struct IKBone {
         HmdVector3_t position;
@@ -126,6 +134,7 @@ public:
     void LoadConfig(const std::string& path);
     void SaveConfig(const std::string& path);
     VRConfig& GetConfig() { return config; }
+    void BakeCalibration();  // Call after changing the config through GetConfig()
 
     // Bethesda tarzı transform fonksiyonları
     HmdMatrix34_t GetWeaponTransform(bool isAiming = false);
@@ -136,7 +145,7 @@ public:
                         IKBone& upperArm, IKBone& forearm);
 
 private:
-    VRManager() = default;
+    VRManager() { BakeCalibration(); }  // Defaults until LoadConfig()
     ~VRManager() = default;
 
     // Yardımcı fonksiyonlar
@@ -0,0 +1,206 @@
+// fnvr_plugin/WakeScheduler.cpp
+#include "WakeScheduler.h"
+#include "LatencyStats.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#else
+#include <chrono>
+#endif
+
+namespace FNVR {
+
+#ifdef _WIN32
+
+WakeScheduler::WakeScheduler()
+    : m_timer(nullptr), m_dataEvent(nullptr), m_stopEvent(nullptr),
+      m_wakeups(0), m_wakeupRate(0), m_windowStart(0.0), m_windowWakeups(0) {}
+
+WakeScheduler::~WakeScheduler()
+{
+    Close();
+}
+
+bool WakeScheduler::Create()
+{
+    if (m_timer) {
+        return true;
+    }
+
+    // High-resolution timers ignore the system timer resolution (no timeBeginPeriod needed)
+    m_timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!m_timer) {
+        m_timer = CreateWaitableTimerW(NULL, FALSE, NULL);
+    }
+    m_dataEvent = CreateEventA(NULL, FALSE, FALSE, NULL);
+    m_stopEvent = CreateEventA(NULL, TRUE, FALSE, NULL);
+    if (!m_timer || !m_dataEvent || !m_stopEvent) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void WakeScheduler::Close()
+{
+    if (m_timer) CloseHandle(static_cast<HANDLE>(m_timer));
+    if (m_dataEvent) CloseHandle(static_cast<HANDLE>(m_dataEvent));
+    if (m_stopEvent) CloseHandle(static_cast<HANDLE>(m_stopEvent));
+    m_timer = nullptr;
+    m_dataEvent = nullptr;
+    m_stopEvent = nullptr;
+}
+
+WakeScheduler::WakeReason WakeScheduler::Wait(double deadline, bool wakeOnData)
+{
+    if (!m_timer) {
+        return kWake_Stop;
+    }
+
+    double now = ClockSync::MonotonicNow();
+    double remaining = deadline - now;
+    DWORD result;
+    if (remaining <= 0.0) {
+        // Already due: only look at the events, never block
+        HANDLE events[2] = { static_cast<HANDLE>(m_stopEvent), static_cast<HANDLE>(m_dataEvent) };
+        result = WaitForMultipleObjects(wakeOnData ? 2 : 1, events, FALSE, 0);
+        if (result == WAIT_OBJECT_0) {
+            return kWake_Stop;
+        }
+        return result == WAIT_OBJECT_0 + 1 ? kWake_NewData : kWake_Deadline;
+    }
+
+    // Relative due time in 100 ns units; re-arming also clears an earlier expiry
+    LARGE_INTEGER due;
+    due.QuadPart = -(LONGLONG)(remaining * 1e7);
+    if (due.QuadPart == 0) {
+        due.QuadPart = -1;
+    }
+    SetWaitableTimer(static_cast<HANDLE>(m_timer), &due, 0, NULL, NULL, FALSE);
+
+    HANDLE handles[3] = { static_cast<HANDLE>(m_stopEvent), static_cast<HANDLE>(m_timer), static_cast<HANDLE>(m_dataEvent) };
+    result = WaitForMultipleObjects(wakeOnData ? 3 : 2, handles, FALSE, INFINITE);
+    CountWakeup(ClockSync::MonotonicNow());
+
+    if (result == WAIT_OBJECT_0 + 1) {
+        return kWake_Deadline;
+    }
+    CancelWaitableTimer(static_cast<HANDLE>(m_timer));
+    return result == WAIT_OBJECT_0 + 2 ? kWake_NewData : kWake_Stop;
+}
+
+void WakeScheduler::NotifyNewData()
+{
+    if (m_dataEvent) {
+        SetEvent(static_cast<HANDLE>(m_dataEvent));
+    }
+}
+
+void WakeScheduler::ResetNewData()
+{
+    if (m_dataEvent) {
+        ResetEvent(static_cast<HANDLE>(m_dataEvent));
+    }
+}
+
+void WakeScheduler::Stop()
+{
+    if (m_stopEvent) {
+        SetEvent(static_cast<HANDLE>(m_stopEvent));
+    }
+}
+
+#else
+
+WakeScheduler::WakeScheduler()
+    : m_dataPending(false), m_waitingForData(false), m_stopRequested(false),
+      m_wakeups(0), m_wakeupRate(0), m_windowStart(0.0), m_windowWakeups(0) {}
+
+WakeScheduler::~WakeScheduler()
+{
+    Close();
+}
+
+bool WakeScheduler::Create()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_dataPending = false;
+    m_stopRequested = false;
+    return true;
+}
+
+void WakeScheduler::Close()
+{
+    Stop();
+}
+
+WakeScheduler::WakeReason WakeScheduler::Wait(double deadline, bool wakeOnData)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_waitingForData = wakeOnData;
+    double remaining = deadline - ClockSync::MonotonicNow();
+    while (!m_stopRequested && !(wakeOnData && m_dataPending) && remaining > 0.0) {
+        m_wake.wait_for(lock, std::chrono::microseconds((int64_t)(remaining * 1e6) + 1));
+        double now = ClockSync::MonotonicNow();
+        CountWakeup(now);
+        remaining = deadline - now;
+    }
+    m_waitingForData = false;
+
+    if (m_stopRequested) {
+        return kWake_Stop;
+    }
+    if (wakeOnData && m_dataPending) {
+        m_dataPending = false;
+        return kWake_NewData;
+    }
+    return kWake_Deadline;
+}
+
+void WakeScheduler::NotifyNewData()
+{
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_dataPending = true;
+        wake = m_waitingForData;
+    }
+    if (wake) {
+        m_wake.notify_one();  // A timer-only wait is left alone, as on Windows
+    }
+}
+
+void WakeScheduler::ResetNewData()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_dataPending = false;
+}
+
+void WakeScheduler::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_wake.notify_all();
+}
+
+#endif
+
+void WakeScheduler::CountWakeup(double now)
+{
+    m_wakeups.fetch_add(1, std::memory_order_relaxed);
+    m_windowWakeups++;
+    if (m_windowStart <= 0.0) {
+        m_windowStart = now;
+    } else if (now - m_windowStart >= 1.0) {
+        m_wakeupRate.store((uint32_t)(m_windowWakeups * 10.0 / (now - m_windowStart)), std::memory_order_relaxed);
+        m_windowStart = now;
+        m_windowWakeups = 0;
+    }
+}
+
+} // namespace FNVR
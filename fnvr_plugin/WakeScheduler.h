@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#ifndef _WIN32
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace FNVR {
+
+// Sleeps a background thread until a deadline, new tracker data, or shutdown -
+// whichever comes first - instead of polling with Sleep(1).
+//
+// Windows: a high-resolution waitable timer (Windows 10 1803+, plain waitable timer
+// before that) plus auto-reset "new data" and manual-reset "stop" events, waited on
+// together. Elsewhere: a condition variable with a timed wait.
+//
+// One thread waits; any thread may notify. Deadlines are ClockSync::MonotonicNow() seconds.
+class WakeScheduler
+{
+public:
+    WakeScheduler();
+    ~WakeScheduler();
+
+    bool Create();
+    void Close();
+
+    enum WakeReason {
+        kWake_Deadline,
+        kWake_NewData,
+        kWake_Stop
+    };
+
+    // Blocks until deadline, or until NotifyNewData() if wakeOnData (a notification
+    // that came in since the last wait counts), or Stop().
+    WakeReason Wait(double deadline, bool wakeOnData);
+
+    // Any thread
+    void NotifyNewData();
+    void Stop();
+
+    // Waiting thread: forget notifications so far. Call before checking for data
+    // and then waiting on it, so a packet already consumed can't cause a wakeup.
+    void ResetNewData();
+
+    // Wakeups of the waiting thread, and their rate over the last complete second
+    uint64_t GetWakeups() const { return m_wakeups.load(std::memory_order_relaxed); }
+    double GetWakeupsPerSecond() const { return m_wakeupRate.load(std::memory_order_relaxed) * 0.1; }
+
+private:
+    void CountWakeup(double now);
+
+#ifdef _WIN32
+    void* m_timer;      // HANDLE
+    void* m_dataEvent;  // HANDLE, auto-reset
+    void* m_stopEvent;  // HANDLE, manual-reset
+#else
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_dataPending;
+    bool m_waitingForData;
+    bool m_stopRequested;
+#endif
+
+    std::atomic<uint64_t> m_wakeups;
+    std::atomic<uint32_t> m_wakeupRate;  // Tenths of a wakeup per second
+
+    // Waiting thread only
+    double m_windowStart;
+    uint64_t m_windowWakeups;
+};
+
+} // namespace FNVR
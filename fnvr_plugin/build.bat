@@ -6,9 +6,9 @@ if exist build rmdir /s /q build
 mkdir build
 cd build
 
-REM Configure CMake for Win32 Release
+REM Configure CMake for Win32 Release (extra options pass through, e.g. -DFNVR_PROFILER=ON)
 echo Configuring CMake...
-cmake -G "Visual Studio 17 2022" -A Win32 -DCMAKE_BUILD_TYPE=Release ..
+cmake -G "Visual Studio 17 2022" -A Win32 -DCMAKE_BUILD_TYPE=Release %* ..
 
 if errorlevel 1 (
     echo CMake configuration failed!
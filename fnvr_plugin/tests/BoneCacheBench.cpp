@@ -0,0 +1,105 @@
+// fnvr_plugin/tests/BoneCacheBench.cpp
+#include "TestUtil.h"
+#include <cstdint>
+#include <map>
+#include <string>
+
+// Per-frame bone lookup cost: the std::map<std::string, BoneCache> that FindBone
+// searched by name, against the NVCSBone-indexed table behind GetCachedBone.
+// A frame looks up the head, the right hand and the weapon node. NiNode and
+// NiTransform are stand-ins of the same shape; PluginMain itself is Win32-only.
+
+namespace {
+
+struct NiNode;
+
+struct NiTransform {
+    float rotate[9];
+    float translate[3];
+    float scale;
+};
+
+// Before: keyed by the bone's name, built from the importantBones list
+struct NamedBoneCache {
+    NiNode* node;
+    std::string name;
+    NiTransform originalTransform;
+};
+
+const char* const kImportantBones[] = {
+    "Bip01", "Bip01 Head", "Bip01 Neck", "Bip01 Neck1",
+    "Bip01 R Hand", "Bip01 L Hand",
+    "Bip01 R Forearm", "Bip01 L Forearm",
+    "Bip01 R UpperArm", "Bip01 L UpperArm",
+    "Weapon", "ProjectileNode"
+};
+const int kImportantBoneCount = sizeof(kImportantBones) / sizeof(kImportantBones[0]);
+
+// After: one slot per NVCSBone (NVCS_BONE_COUNT of them)
+enum {
+    kBone_Head = 8,        // NVCS_BIP01_HEAD
+    kBone_RightHand = 12,  // NVCS_BIP01_R_HAND
+    kBone_Weapon = 23,     // NVCS_WEAPON
+    kBoneCount = 32        // NVCS_BONE_COUNT
+};
+
+struct BoneCacheEntry {
+    NiNode* node;
+    NiTransform originalTransform;
+};
+
+struct BoneCache {
+    BoneCacheEntry bones[kBoneCount];
+};
+
+NiNode* FakeNode(int i)
+{
+    return reinterpret_cast<NiNode*>((uintptr_t)(i + 1) * 64);
+}
+
+} // namespace
+
+int main()
+{
+    std::map<std::string, NamedBoneCache> named;
+    for (int i = 0; i < kImportantBoneCount; i++) {
+        NamedBoneCache& entry = named[kImportantBones[i]];
+        entry.node = FakeNode(i);
+        entry.name = kImportantBones[i];
+    }
+
+    BoneCache indexed = {};
+    indexed.bones[kBone_Head].node = FakeNode(1);
+    indexed.bones[kBone_RightHand].node = FakeNode(4);
+    indexed.bones[kBone_Weapon].node = FakeNode(10);
+
+    // Names and indices read through volatiles so the compiler cannot fold the
+    // lookups away
+    const char* const* volatile names = kImportantBones;
+    volatile int head = kBone_Head, rightHand = kBone_RightHand, weapon = kBone_Weapon;
+
+    const int iterations = 2000000;
+
+    double namedNs = FNVRTest::NsPerCall(iterations, [&](int) {
+        NiNode* found = named.find(names[1])->second.node;
+        FNVRTest::KeepAlive(found);
+        found = named.find(names[4])->second.node;
+        FNVRTest::KeepAlive(found);
+        found = named.find(names[10])->second.node;
+        FNVRTest::KeepAlive(found);
+    });
+
+    double indexedNs = FNVRTest::NsPerCall(iterations, [&](int) {
+        NiNode* found = indexed.bones[head].node;
+        FNVRTest::KeepAlive(found);
+        found = indexed.bones[rightHand].node;
+        FNVRTest::KeepAlive(found);
+        found = indexed.bones[weapon].node;
+        FNVRTest::KeepAlive(found);
+    });
+
+    printf("per frame, head + right hand + weapon lookups\n");
+    printf("  std::map<std::string> by name  %7.2f ns\n", namedNs);
+    printf("  NVCSBone-indexed table         %7.2f ns\n", indexedNs);
+    return 0;
+}
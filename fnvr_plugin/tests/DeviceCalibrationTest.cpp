@@ -0,0 +1,158 @@
+// fnvr_plugin/tests/DeviceCalibrationTest.cpp
+#include "DeviceCalibration.h"
+#include "CoordinateFrames.h"
+#include "PoseMathScalar.h"
+#include "VRPacketView.h"
+#include "TestUtil.h"
+#include <cmath>
+
+// The hand chains NVCSSkeleton::VRToNVCSMapping::RefreshHandCalibration bakes, against
+// the per-call math MapControllerToHand ran before: frame change with the VorpX scale,
+// the -45 degree grip pitch and 5 degree VorpX yaw on the right hand, the X mirror on
+// the left, then the INI offsets. Random poses, scales and offsets, VorpX on and off.
+
+using namespace FNVR;
+
+namespace {
+
+const int kSamples = 100000;
+const float kPi = 3.14159f;  // As NVCSSkeleton.cpp spells it
+
+struct HandSettings {
+    bool vorpxMode;
+    float scale;
+    float offset[3];
+};
+
+// RefreshHandCalibration's chains
+void BakeHands(const HandSettings& settings, DeviceCalibration& right, DeviceCalibration& left)
+{
+    MatrixRows toGame;
+    OpenVRToGamebryo::Rows(settings.scale, toGame);
+    __m128 basis = OpenVRToGamebryo::Rotation();
+
+    right.SetIdentity();
+    right.AppendTransform(toGame);
+    right.AppendOffset(settings.offset[0], settings.offset[1], settings.offset[2]);
+    right.AppendRotation(basis, QuatConjugate(basis));
+    right.AppendRotation(MakeQuat(1.0f, 0.0f, 0.0f, 0.0f), QuatFromAxisAngle(1.0f, 0.0f, 0.0f, -45.0f * kPi / 180.0f));
+    if (settings.vorpxMode) {
+        right.AppendRotation(QuatFromAxisAngle(0.0f, 1.0f, 0.0f, 5.0f * kPi / 180.0f), MakeQuat(1.0f, 0.0f, 0.0f, 0.0f));
+    }
+
+    MatrixRows mirrorX;
+    mirrorX.row[0] = _mm_setr_ps(-1.0f, 0.0f, 0.0f, 0.0f);
+    mirrorX.row[1] = _mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f);
+    mirrorX.row[2] = _mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f);
+    __m128 turnX = MakeQuat(0.0f, 1.0f, 0.0f, 0.0f);
+    left.SetIdentity();
+    left.AppendTransform(toGame);
+    left.AppendTransform(mirrorX);
+    left.AppendOffset(settings.offset[0], settings.offset[1], settings.offset[2]);
+    left.AppendRotation(basis, QuatConjugate(basis));
+    left.AppendRotation(turnX, QuatConjugate(turnX));
+}
+
+// MapControllerToHand before the chains were baked
+void PerCallHand(const HandSettings& settings, const VRPose& controller, bool isRight, float* position, float* rotation)
+{
+    OpenVRToGamebryo::Position(&controller.px, position, settings.scale);
+    OpenVRToGamebryo::Orientation(&controller.qw, rotation);
+    if (isRight) {
+        float gripAngle = -45.0f * kPi / 180.0f;
+        const float grip[4] = { cosf(gripAngle / 2), sinf(gripAngle / 2), 0.0f, 0.0f };
+        __m128 rot = QuatMultiply(LoadQuat(rotation), LoadQuat(grip));
+        if (settings.vorpxMode) {
+            float yawOffset = 5.0f * kPi / 180.0f;
+            const float yaw[4] = { cosf(yawOffset / 2), 0.0f, sinf(yawOffset / 2), 0.0f };
+            rot = QuatMultiply(LoadQuat(yaw), rot);
+        }
+        StoreQuat(rotation, rot);
+    } else {
+        position[0] = -position[0];
+        rotation[2] = -rotation[2];
+        rotation[3] = -rotation[3];
+    }
+    for (int i = 0; i < 3; i++) {
+        position[i] += settings.offset[i];
+    }
+}
+
+void TestHandChains()
+{
+    FNVRTest::UniformFloats random(17);
+    double positionError = 0.0;
+    double rotationError = 0.0;
+    for (int i = 0; i < kSamples; i++) {
+        HandSettings settings;
+        settings.vorpxMode = (i & 1) != 0;
+        settings.scale = 1.5f + 0.5f * random.Next();
+        for (int a = 0; a < 3; a++) {
+            settings.offset[a] = 20.0f * random.Next();
+        }
+        DeviceCalibration right, left;
+        BakeHands(settings, right, left);
+
+        VRPose controller;
+        FNVRTest::ScalarQuat q = FNVRTest::ScalarQuatNormalize({ random.Next(), random.Next(), random.Next(), random.Next() });
+        controller.qw = q.w;
+        controller.qx = q.x;
+        controller.qy = q.y;
+        controller.qz = q.z;
+        controller.px = random.Next() * 2.0f;
+        controller.py = random.Next() * 2.0f;
+        controller.pz = random.Next() * 2.0f;
+
+        for (int hand = 0; hand < 2; hand++) {
+            const DeviceCalibration& baked = hand ? right : left;
+            float expectedPosition[3], expectedRotation[4];
+            PerCallHand(settings, controller, hand != 0, expectedPosition, expectedRotation);
+
+            float position[3], rotation[4];
+            baked.TransformPosition(&controller.px, position);
+            StoreQuat(rotation, baked.TransformRotation(LoadQuat(&controller.qw)));
+            for (int a = 0; a < 3; a++) {
+                positionError = fmax(positionError, fabs(position[a] - expectedPosition[a]));
+            }
+            for (int a = 0; a < 4; a++) {
+                rotationError = fmax(rotationError, fabs(rotation[a] - expectedRotation[a]));
+            }
+        }
+    }
+    printf("  hand chains     max error %.2g game units, %.2g (quaternion)\n", positionError, rotationError);
+    FNVR_CHECK(positionError <= 1e-4);  // |result| <= 300
+    FNVR_CHECK(rotationError <= 1e-6);
+}
+
+void TestEulerDegrees()
+{
+    // Roll about X, pitch about Y, yaw about Z, applied roll first
+    FNVRTest::UniformFloats random(19);
+    double maxError = 0.0;
+    for (int i = 0; i < kSamples; i++) {
+        float pitch = 180.0f * random.Next();
+        float yaw = 180.0f * random.Next();
+        float roll = 180.0f * random.Next();
+        const float toRad = 3.14159265359f / 180.0f;
+        __m128 expected = QuatMultiply(QuatFromAxisAngle(0.0f, 0.0f, 1.0f, yaw * toRad),
+                          QuatMultiply(QuatFromAxisAngle(0.0f, 1.0f, 0.0f, pitch * toRad),
+                                       QuatFromAxisAngle(1.0f, 0.0f, 0.0f, roll * toRad)));
+        float a[4], b[4];
+        StoreQuat(a, QuatFromEulerDegrees(pitch, yaw, roll));
+        StoreQuat(b, expected);
+        for (int c = 0; c < 4; c++) {
+            maxError = fmax(maxError, fabs(a[c] - b[c]));
+        }
+    }
+    printf("  QuatFromEulerDegrees max error %.2g\n", maxError);
+    FNVR_CHECK(maxError <= 1e-6);
+}
+
+} // namespace
+
+int main()
+{
+    TestHandChains();
+    TestEulerDegrees();
+    return FNVRTest::Finish("DeviceCalibrationTest");
+}
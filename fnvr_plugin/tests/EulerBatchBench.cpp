@@ -0,0 +1,60 @@
+// fnvr_plugin/tests/EulerBatchBench.cpp
+#include "EulerBatch.h"
+#include "EulerScalar.h"
+#include "TestUtil.h"
+
+// Per-frame cost of the script globals' Euler angles: three QuaternionToEuler calls
+// (HMD, right, left) against one EulerBatch::Convert for all three.
+
+namespace {
+
+const int kInputs = 64;  // Cycled through so the compiler cannot hoist the work
+
+} // namespace
+
+int main()
+{
+    // Unit quaternions spread over the sphere
+    static float quats[kInputs][4];
+    for (int i = 0; i < kInputs; i++) {
+        double a1 = 1.5707963 * (i + 0.5) / kInputs;
+        double a2 = 0.7 * i;
+        double a3 = 1.3 * i;
+        quats[i][0] = (float)(cos(a1) * cos(a2));
+        quats[i][1] = (float)(cos(a1) * sin(a2));
+        quats[i][2] = (float)(sin(a1) * cos(a3));
+        quats[i][3] = (float)(sin(a1) * sin(a3));
+    }
+
+    const int iterations = 2000000;
+    const int mask = kInputs - 1;
+
+    double scalarNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        float angles[3][3];
+        for (int d = 0; d < 3; d++) {
+            const float* q = quats[(i + d) & mask];
+            FNVRTest::QuaternionToEuler(q[0], q[1], q[2], q[3], angles[d][0], angles[d][1], angles[d][2]);
+        }
+        FNVRTest::KeepAlive(angles);
+    });
+
+    double batchNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        FNVR::EulerBatch batch;
+        for (int d = 0; d < 3; d++) {
+            const float* q = quats[(i + d) & mask];
+            batch.qw[d] = q[0];
+            batch.qx[d] = q[1];
+            batch.qy[d] = q[2];
+            batch.qz[d] = q[3];
+        }
+        batch.qw[3] = 1.0f;  // Identity in the spare lane, as Globals.cpp fills it
+        batch.qx[3] = batch.qy[3] = batch.qz[3] = 0.0f;
+        batch.Convert();
+        FNVRTest::KeepAlive(batch);
+    });
+
+    printf("per frame, three rotations to Euler angles\n");
+    printf("  QuaternionToEuler x3     %7.2f ns\n", scalarNs);
+    printf("  EulerBatch::Convert      %7.2f ns\n", batchNs);
+    return 0;
+}
@@ -0,0 +1,151 @@
+// fnvr_plugin/tests/EulerBatchTest.cpp
+#include "EulerBatch.h"
+#include "EulerScalar.h"
+#include "TestUtil.h"
+#include <cmath>
+
+// The bounds documented in EulerBatch.h: Atan2Degrees and AsinDegrees within 3e-5
+// degrees of libm in double on the same float inputs, and the batch within 1e-4
+// degrees of the float QuaternionToEuler, over a sweep of the rotation sphere.
+
+using namespace FNVR;
+
+namespace {
+
+const double kDegrees = 180.0 / 3.14159265358979323846;
+const double kKernelBound = 3e-5;
+
+// |a - b| in degrees, across the +/-180 seam
+double AngleError(double a, double b)
+{
+    double d = fmod(fabs(a - b), 360.0);
+    return d > 180.0 ? 360.0 - d : d;
+}
+
+float Lane0(__m128 v)
+{
+    return _mm_cvtss_f32(v);
+}
+
+void TestAtan2Circle()
+{
+    // The whole circle at radii from tiny to large
+    const int steps = 1000000;
+    const float radii[] = { 1e-3f, 1.0f, 7.5f };
+    double maxError = 0.0;
+    for (int k = 0; k < steps; k++) {
+        double angle = -3.14159265358979323846 + 2.0 * 3.14159265358979323846 * k / steps;
+        for (float radius : radii) {
+            float y = (float)(radius * sin(angle));
+            float x = (float)(radius * cos(angle));
+            float result = Lane0(Atan2Degrees(_mm_set1_ps(y), _mm_set1_ps(x)));
+            maxError = fmax(maxError, AngleError(result, atan2((double)y, (double)x) * kDegrees));
+        }
+    }
+    printf("  Atan2Degrees over the circle  max error %.2g deg\n", maxError);
+    FNVR_CHECK(maxError <= kKernelBound);
+
+    // Signed zeros as libm: (+0, +0) 0, (-0, +0) -0, (+0, -0) 180, (-0, -0) -180
+    float zeros[4];
+    _mm_storeu_ps(zeros, Atan2Degrees(_mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f), _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f)));
+    FNVR_CHECK(zeros[0] == 0.0f && !std::signbit(zeros[0]));
+    FNVR_CHECK(zeros[1] == 0.0f && std::signbit(zeros[1]));
+    FNVR_CHECK(zeros[2] == 180.0f);
+    FNVR_CHECK(zeros[3] == -180.0f);
+}
+
+void TestAsin()
+{
+    double maxError = 0.0;
+    const int steps = 2000000;
+    for (int k = 0; k <= steps; k++) {
+        float s = (float)(-1.0 + 2.0 * k / steps);
+        maxError = fmax(maxError, fabs(Lane0(AsinDegrees(_mm_set1_ps(s))) - asin((double)s) * kDegrees));
+    }
+
+    // Every float from 1 down to 0.999, where 1 - s*s would cancel
+    for (float s = 1.0f; s > 0.999f; s = nextafterf(s, 0.0f)) {
+        float out[4];
+        _mm_storeu_ps(out, AsinDegrees(_mm_setr_ps(s, -s, s, -s)));
+        maxError = fmax(maxError, fabs(out[0] - asin((double)s) * kDegrees));
+        maxError = fmax(maxError, fabs(out[1] + asin((double)s) * kDegrees));
+    }
+    printf("  AsinDegrees over [-1, 1]      max error %.2g deg\n", maxError);
+    FNVR_CHECK(maxError <= kKernelBound);
+
+    // Out of range clamps to +/-90
+    float out[4];
+    _mm_storeu_ps(out, AsinDegrees(_mm_setr_ps(1.5f, -1.0001f, 1.0f, -1.0f)));
+    FNVR_CHECK(out[0] == 90.0f && out[1] == -90.0f && out[2] == 90.0f && out[3] == -90.0f);
+}
+
+void TestSphereSweep()
+{
+    // Unit quaternions on a grid over the 3-sphere: w + xi = cos(a1) e^(i a2),
+    // y + zj = sin(a1) e^(i a3)
+    const int grid = 160;  // 4M rotations
+    const double pi = 3.14159265358979323846;
+    double maxLibm = 0.0;
+    double maxFloat = 0.0;
+    long rotations = 0;
+
+    EulerBatch batch;
+    float expected[4][3];   // Float QuaternionToEuler: pitch, yaw, roll
+    double exact[4][3];     // libm in double on the same float inputs
+    int lane = 0;
+    for (int i = 0; i < grid; i++) {
+        for (int j = 0; j < grid; j++) {
+            for (int k = 0; k < grid; k++) {
+                double a1 = pi / 2 * (i + 0.5) / grid;
+                double a2 = 2 * pi * j / grid;
+                double a3 = 2 * pi * k / grid;
+                float w = (float)(cos(a1) * cos(a2));
+                float x = (float)(cos(a1) * sin(a2));
+                float y = (float)(sin(a1) * cos(a3));
+                float z = (float)(sin(a1) * sin(a3));
+                batch.qw[lane] = w;
+                batch.qx[lane] = x;
+                batch.qy[lane] = y;
+                batch.qz[lane] = z;
+                FNVRTest::QuaternionToEuler(w, x, y, z, expected[lane][0], expected[lane][1], expected[lane][2]);
+
+                float sinp = 2.0f * (w * y - z * x);
+                float sinyCosp = 2.0f * (w * z + x * y);
+                float cosyCosp = 1.0f - 2.0f * (y * y + z * z);
+                float sinrCosp = 2.0f * (w * x + y * z);
+                float cosrCosp = 1.0f - 2.0f * (x * x + y * y);
+                exact[lane][0] = fabs(sinp) >= 1.0f ? copysign(90.0, sinp) : asin((double)sinp) * kDegrees;
+                exact[lane][1] = atan2((double)sinyCosp, (double)cosyCosp) * kDegrees;
+                exact[lane][2] = atan2((double)sinrCosp, (double)cosrCosp) * kDegrees;
+
+                if (++lane < 4) {
+                    continue;
+                }
+                batch.Convert();
+                for (int l = 0; l < 4; l++) {
+                    const float got[3] = { batch.pitch[l], batch.yaw[l], batch.roll[l] };
+                    for (int a = 0; a < 3; a++) {
+                        maxLibm = fmax(maxLibm, AngleError(got[a], exact[l][a]));
+                        maxFloat = fmax(maxFloat, AngleError(got[a], expected[l][a]));
+                    }
+                    rotations++;
+                }
+                lane = 0;
+            }
+        }
+    }
+    printf("  sphere sweep, %ld rotations   max error %.2g deg (libm), %.2g deg (QuaternionToEuler)\n",
+           rotations, maxLibm, maxFloat);
+    FNVR_CHECK(maxLibm <= kKernelBound);
+    FNVR_CHECK(maxFloat <= 1e-4);
+}
+
+} // namespace
+
+int main()
+{
+    TestAtan2Circle();
+    TestAsin();
+    TestSphereSweep();
+    return FNVRTest::Finish("EulerBatchTest");
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cmath>
+
+// TESGlobals::QuaternionToEuler (Globals.cpp) as it stands: float libm, one rotation
+// at a time. Reference for EulerBatchTest and baseline for EulerBatchBench.
+
+namespace FNVRTest {
+
+inline void QuaternionToEuler(float qw, float qx, float qy, float qz, float& pitch, float& yaw, float& roll)
+{
+    // Roll (x-axis rotation)
+    float sinr_cosp = 2.0f * (qw * qx + qy * qz);
+    float cosr_cosp = 1.0f - 2.0f * (qx * qx + qy * qy);
+    roll = std::atan2(sinr_cosp, cosr_cosp) * 180.0f / 3.14159265359f;
+
+    // Pitch (y-axis rotation)
+    float sinp = 2.0f * (qw * qy - qz * qx);
+    if (std::abs(sinp) >= 1)
+        pitch = std::copysign(90.0f, sinp); // use 90 degrees if out of range
+    else
+        pitch = std::asin(sinp) * 180.0f / 3.14159265359f;
+
+    // Yaw (z-axis rotation)
+    float siny_cosp = 2.0f * (qw * qz + qx * qy);
+    float cosy_cosp = 1.0f - 2.0f * (qy * qy + qz * qz);
+    yaw = std::atan2(siny_cosp, cosy_cosp) * 180.0f / 3.14159265359f;
+}
+
+} // namespace FNVRTest
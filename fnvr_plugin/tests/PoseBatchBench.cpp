@@ -0,0 +1,65 @@
+// fnvr_plugin/tests/PoseBatchBench.cpp
+#include "PoseBatch.h"
+#include "CoordinateFrames.h"
+#include "PoseMathScalar.h"
+#include "TestUtil.h"
+
+// Per-frame cost of converting every tracked device to game space: the single-pose
+// kernels once per device against LoadPoseBatch + ConvertPoseBatch.
+
+using namespace FNVR;
+
+namespace {
+
+const int kInputs = 64;  // Cycled through so the compiler cannot hoist the work
+
+} // namespace
+
+int main()
+{
+    static PoseSample samples[kInputs];
+    FNVRTest::UniformFloats random(13);
+    for (int i = 0; i < kInputs; i++) {
+        for (int d = 0; d < kPose_Count; d++) {
+            VRPose& pose = samples[i].poses[d];
+            pose.qw = random.Next();
+            pose.qx = random.Next();
+            pose.qy = random.Next();
+            pose.qz = random.Next();
+            pose.px = random.Next() * 2.0f;
+            pose.py = random.Next() * 2.0f;
+            pose.pz = random.Next() * 2.0f;
+        }
+    }
+
+    const int iterations = 2000000;
+    const int mask = kInputs - 1;
+    const float scale = 70.0f;
+
+    double kernelNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        float out[kPose_Count][12];
+        for (int d = 0; d < kPose_Count; d++) {
+            const VRPose& pose = samples[i & mask].poses[d];
+            MatrixRows rows;
+            QuatToRows(QuatNormalize(QuatMultiply(OpenVRToGamebryoQuat(), LoadQuat(&pose.qw))), rows);
+            StoreRows33(out[d], rows);
+            out[d][9] = pose.px * scale;
+            out[d][10] = -pose.pz * scale;
+            out[d][11] = pose.py * scale;
+        }
+        FNVRTest::KeepAlive(out);
+    });
+
+    double batchNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        PoseBatch batch;
+        LoadPoseBatch(samples[i & mask], batch);
+        ConvertedPoseBatch converted;
+        ConvertPoseBatch(batch, scale, converted);
+        FNVRTest::KeepAlive(converted);
+    });
+
+    printf("per frame, %d devices to game space\n", (int)kPose_Count);
+    printf("  PoseMath kernels per device  %7.2f ns\n", kernelNs);
+    printf("  ConvertPoseBatch             %7.2f ns\n", batchNs);
+    return 0;
+}
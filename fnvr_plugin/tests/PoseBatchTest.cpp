@@ -0,0 +1,136 @@
+// fnvr_plugin/tests/PoseBatchTest.cpp
+#include "PoseBatch.h"
+#include "CoordinateFrames.h"
+#include "PoseMathScalar.h"
+#include "TestUtil.h"
+#include <cmath>
+
+// ConvertPoseBatch lane by lane against the single-pose kernels it writes out by hand:
+// QuatMultiply(OpenVRToGamebryoQuat(), q) -> QuatNormalize -> QuatToRows, and the
+// (x, -z, y) * scale position. Covers random non-unit input, a zero quaternion and the
+// identity padding lanes LoadPoseBatch adds past kPose_Count.
+
+using namespace FNVR;
+
+namespace {
+
+const int kSamples = 100000;
+
+struct LaneError {
+    double position;
+    double rotation;
+    double matrix;
+};
+
+void CheckLane(const PoseBatch& in, float scale, const ConvertedPoseBatch& out, int lane, LaneError& error)
+{
+    const float position[3] = { in.px[lane] * scale, -in.pz[lane] * scale, in.py[lane] * scale };
+    const float got[3] = { out.px[lane], out.py[lane], out.pz[lane] };
+    for (int i = 0; i < 3; i++) {
+        error.position = fmax(error.position, fabs(got[i] - position[i]));
+    }
+
+    const float q[4] = { in.qw[lane], in.qx[lane], in.qy[lane], in.qz[lane] };
+    __m128 game = QuatNormalize(QuatMultiply(OpenVRToGamebryoQuat(), LoadQuat(q)));
+    float expected[4];
+    StoreQuat(expected, game);
+    const float rotation[4] = { out.qw[lane], out.qx[lane], out.qy[lane], out.qz[lane] };
+    for (int i = 0; i < 4; i++) {
+        error.rotation = fmax(error.rotation, fabs(rotation[i] - expected[i]));
+    }
+
+    MatrixRows rows;
+    QuatToRows(game, rows);
+    float matrix[9];
+    StoreRows33(matrix, rows);
+    float batchMatrix[9];
+    out.GetRotation(lane, batchMatrix);
+    for (int i = 0; i < 9; i++) {
+        error.matrix = fmax(error.matrix, fabs(batchMatrix[i] - matrix[i]));
+    }
+}
+
+void TestRandomPoses()
+{
+    FNVRTest::UniformFloats random(11);
+    LaneError error = { 0.0, 0.0, 0.0 };
+    for (int i = 0; i < kSamples; i++) {
+        PoseSample sample;
+        sample.timestamp = i;
+        for (int d = 0; d < kPose_Count; d++) {
+            // Unnormalized, as interpolated and extrapolated poses can be
+            VRPose& pose = sample.poses[d];
+            pose.qw = random.Next();
+            pose.qx = random.Next();
+            pose.qy = random.Next();
+            pose.qz = random.Next();
+            pose.px = random.Next() * 2.0f;
+            pose.py = random.Next() * 2.0f;
+            pose.pz = random.Next() * 2.0f;
+        }
+        float scale = 50.0f + 30.0f * random.Next();
+
+        PoseBatch batch;
+        LoadPoseBatch(sample, batch);
+        ConvertedPoseBatch converted;
+        ConvertPoseBatch(batch, scale, converted);
+        for (int lane = 0; lane < kPoseBatchLanes; lane++) {
+            CheckLane(batch, scale, converted, lane, error);
+        }
+    }
+    printf("  random poses    max error %.2g (position), %.2g (rotation), %.2g (matrix)\n",
+           error.position, error.rotation, error.matrix);
+    FNVR_CHECK(error.position <= 2e-5);  // |result| <= 160
+    FNVR_CHECK(error.rotation <= 5e-7);
+    FNVR_CHECK(error.matrix <= 2e-6);
+}
+
+void TestZeroAndPadding()
+{
+    PoseSample sample;
+    sample.timestamp = 0.0;
+    for (int d = 0; d < kPose_Count; d++) {
+        VRPose& pose = sample.poses[d];
+        pose.qw = 1.0f;
+        pose.qx = pose.qy = pose.qz = 0.0f;
+        pose.px = 0.25f * (d + 1);
+        pose.py = -0.5f;
+        pose.pz = 1.5f;
+    }
+    // A device with no pose yet sends a zero quaternion
+    VRPose& zero = sample.poses[kPose_Left];
+    zero.qw = zero.qx = zero.qy = zero.qz = 0.0f;
+
+    PoseBatch batch;
+    LoadPoseBatch(sample, batch);
+    for (int lane = kPose_Count; lane < kPoseBatchLanes; lane++) {
+        FNVR_CHECK(batch.qw[lane] == 1.0f && batch.qx[lane] == 0.0f && batch.qy[lane] == 0.0f && batch.qz[lane] == 0.0f);
+        FNVR_CHECK(batch.px[lane] == 0.0f && batch.py[lane] == 0.0f && batch.pz[lane] == 0.0f);
+    }
+
+    ConvertedPoseBatch converted;
+    ConvertPoseBatch(batch, 70.0f, converted);
+    LaneError error = { 0.0, 0.0, 0.0 };
+    for (int lane = 0; lane < kPoseBatchLanes; lane++) {
+        CheckLane(batch, 70.0f, converted, lane, error);
+    }
+    FNVR_CHECK(error.position <= 1e-5 && error.rotation <= 5e-7 && error.matrix <= 2e-6);
+
+    // The zero quaternion stays zero (not NaN) and its matrix is the identity
+    const int z = kPose_Left;
+    FNVR_CHECK(converted.qw[z] == 0.0f && converted.qx[z] == 0.0f && converted.qy[z] == 0.0f && converted.qz[z] == 0.0f);
+    float matrix[9];
+    converted.GetRotation(z, matrix);
+    for (int i = 0; i < 9; i++) {
+        FNVR_CHECK(matrix[i] == (i % 4 == 0 ? 1.0f : 0.0f));
+    }
+}
+
+} // namespace
+
+int main()
+{
+    TestRandomPoses();
+    TestZeroAndPadding();
+    return FNVRTest::Finish("PoseBatchTest");
+}
@@ -0,0 +1,112 @@
+// fnvr_plugin/tests/PoseMailboxTest.cpp
+#include "PoseMailbox.h"
+#include "TestUtil.h"
+#include <atomic>
+#include <thread>
+
+namespace {
+
+// Packet-sized payload whose every word carries the sequence number, so a torn
+// read (slot reused while the consumer reads it) shows up as a mismatch
+struct Sample {
+    uint64_t sequence;
+    uint64_t words[18];
+};
+
+void Fill(Sample& sample, uint64_t sequence)
+{
+    sample.sequence = sequence;
+    for (int i = 0; i < 18; i++) {
+        sample.words[i] = sequence * 31 + i;
+    }
+}
+
+bool IsWhole(const Sample& sample)
+{
+    for (int i = 0; i < 18; i++) {
+        if (sample.words[i] != sample.sequence * 31 + i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TestSingleThread()
+{
+    FNVR::PoseMailbox<Sample> mailbox;
+    FNVR_CHECK(!mailbox.HasNew());
+    FNVR_CHECK(!mailbox.Acquire());
+
+    Sample sample;
+    Fill(sample, 1);
+    mailbox.Publish(sample);
+    FNVR_CHECK(mailbox.HasNew());
+    FNVR_CHECK(mailbox.Acquire());
+    FNVR_CHECK(mailbox.Front().sequence == 1);
+
+    // Nothing new: Front() stays on the last acquired value
+    FNVR_CHECK(!mailbox.Acquire());
+    FNVR_CHECK(mailbox.Front().sequence == 1);
+
+    // Latest wins: only the newest of several publishes is seen
+    for (uint64_t i = 2; i <= 5; i++) {
+        Fill(mailbox.BeginWrite(), i);
+        mailbox.Publish();
+    }
+    FNVR_CHECK(mailbox.Acquire());
+    FNVR_CHECK(mailbox.Front().sequence == 5);
+    FNVR_CHECK(IsWhole(mailbox.Front()));
+    FNVR_CHECK(!mailbox.Acquire());
+    FNVR_CHECK(mailbox.PublishedCount() == 5);
+}
+
+// One producer publishing as fast as it can, one consumer acquiring as fast as it
+// can: every acquired value must be whole, newer than the last, and the final
+// value must arrive
+void TestStress()
+{
+    const uint64_t count = 2000000;
+    FNVR::PoseMailbox<Sample> mailbox;
+    std::atomic<bool> badOrder(false);
+
+    std::thread producer([&] {
+        for (uint64_t i = 1; i <= count; i++) {
+            Fill(mailbox.BeginWrite(), i);
+            mailbox.Publish();
+        }
+    });
+
+    uint64_t last = 0;
+    uint64_t acquired = 0;
+    uint64_t torn = 0;
+    while (last < count) {
+        if (!mailbox.Acquire()) {
+            continue;
+        }
+        const Sample& sample = mailbox.Front();
+        if (!IsWhole(sample)) {
+            torn++;
+        }
+        if (sample.sequence <= last) {
+            badOrder = true;
+        }
+        last = sample.sequence;
+        acquired++;
+    }
+    producer.join();
+
+    FNVR_CHECK(torn == 0);
+    FNVR_CHECK(!badOrder);
+    FNVR_CHECK(last == count);
+    FNVR_CHECK(mailbox.PublishedCount() == count);
+    printf("stress: %llu published, %llu acquired\n", (unsigned long long)count, (unsigned long long)acquired);
+}
+
+} // namespace
+
+int main()
+{
+    TestSingleThread();
+    TestStress();
+    return FNVRTest::Finish("PoseMailboxTest");
+}
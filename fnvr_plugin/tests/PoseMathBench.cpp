@@ -0,0 +1,127 @@
+// fnvr_plugin/tests/PoseMathBench.cpp
+#include "PoseMath.h"
+#include "PoseMathScalar.h"
+#include "TestUtil.h"
+
+// Nanoseconds per call, scalar code against the SSE kernel, for each kernel and for
+// the chain SetBoneFromPose runs per bone: OpenVR -> game rotation, normalize, matrix.
+
+using namespace FNVR;
+using FNVRTest::ScalarQuat;
+
+namespace {
+
+const int kInputs = 64;  // Cycled through so the compiler cannot hoist the work
+
+struct Inputs {
+    ScalarQuat quats[kInputs];
+    float matrices[kInputs][3][4];
+    float points[kInputs][3];
+};
+
+} // namespace
+
+int main()
+{
+    static Inputs in;
+    FNVRTest::UniformFloats random(7);
+    for (int i = 0; i < kInputs; i++) {
+        in.quats[i].w = random.Next();
+        in.quats[i].x = random.Next();
+        in.quats[i].y = random.Next();
+        in.quats[i].z = random.Next();
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 4; c++) {
+                in.matrices[i][r][c] = random.Next() * 3.0f;
+            }
+            in.points[i][r] = random.Next() * 100.0f;
+        }
+    }
+
+    const int iterations = 5000000;
+    const int mask = kInputs - 1;
+    printf("ns per call            scalar      sse\n");
+
+    double scalarNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        ScalarQuat r = FNVRTest::ScalarQuatMultiply(in.quats[i & mask], in.quats[(i + 1) & mask]);
+        FNVRTest::KeepAlive(r);
+    });
+    double sseNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        __m128 r = QuatMultiply(LoadQuat(&in.quats[i & mask].w), LoadQuat(&in.quats[(i + 1) & mask].w));
+        FNVRTest::KeepAlive(r);
+    });
+    printf("  QuatMultiply       %8.2f %8.2f\n", scalarNs, sseNs);
+
+    scalarNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        ScalarQuat r = FNVRTest::ScalarQuatNormalize(in.quats[i & mask]);
+        FNVRTest::KeepAlive(r);
+    });
+    sseNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        __m128 r = QuatNormalize(LoadQuat(&in.quats[i & mask].w));
+        FNVRTest::KeepAlive(r);
+    });
+    printf("  QuatNormalize      %8.2f %8.2f\n", scalarNs, sseNs);
+
+    scalarNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        float m[3][4];
+        FNVRTest::ScalarQuatToMatrix(in.quats[i & mask], m);
+        FNVRTest::KeepAlive(m);
+    });
+    sseNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        MatrixRows rows;
+        QuatToRows(LoadQuat(&in.quats[i & mask].w), rows);
+        float m[12];
+        StoreRows34(m, rows);
+        FNVRTest::KeepAlive(m);
+    });
+    printf("  QuatToRows         %8.2f %8.2f\n", scalarNs, sseNs);
+
+    scalarNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        float m[3][4];
+        FNVRTest::ScalarMultiplyMatrices(in.matrices[i & mask], in.matrices[(i + 1) & mask], m);
+        FNVRTest::KeepAlive(m);
+    });
+    sseNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        MatrixRows a, b;
+        LoadRows34(&in.matrices[i & mask][0][0], a);
+        LoadRows34(&in.matrices[(i + 1) & mask][0][0], b);
+        ComposeRows(a, b, a);
+        float m[12];
+        StoreRows34(m, a);
+        FNVRTest::KeepAlive(m);
+    });
+    printf("  ComposeRows        %8.2f %8.2f\n", scalarNs, sseNs);
+
+    scalarNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        float out[3];
+        FNVRTest::ScalarTransformPoint(in.matrices[i & mask], in.points[i & mask], out);
+        FNVRTest::KeepAlive(out);
+    });
+    sseNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        MatrixRows rows;
+        LoadRows34(&in.matrices[i & mask][0][0], rows);
+        float out[3];
+        TransformPoint(rows, in.points[i & mask], out);
+        FNVRTest::KeepAlive(out);
+    });
+    printf("  TransformPoint     %8.2f %8.2f\n", scalarNs, sseNs);
+
+    // OpenVR -> game is a product with a fixed quarter turn about x
+    const ScalarQuat toGame = { 0.7071067811865476f, -0.7071067811865476f, 0.0f, 0.0f };
+    scalarNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        ScalarQuat q = FNVRTest::ScalarQuatNormalize(FNVRTest::ScalarQuatMultiply(toGame, in.quats[i & mask]));
+        float m[3][4];
+        FNVRTest::ScalarQuatToMatrix(q, m);
+        FNVRTest::KeepAlive(m);
+    });
+    const __m128 toGameSse = LoadQuat(&toGame.w);
+    sseNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        MatrixRows rows;
+        QuatToRows(QuatNormalize(QuatMultiply(toGameSse, LoadQuat(&in.quats[i & mask].w))), rows);
+        float m[9];
+        StoreRows33(m, rows);
+        FNVRTest::KeepAlive(m);
+    });
+    printf("  pose -> bone matrix %7.2f %8.2f\n", scalarNs, sseNs);
+    return 0;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+// Scalar versions of the PoseMath kernels, as the code they replaced wrote them
+// (VRManager's QuaternionToMatrix, MultiplyMatrices and TransformPoint, the normalize
+// in SetBoneFromPose). Reference for PoseMathTest and baseline for PoseMathBench.
+
+namespace FNVRTest {
+
+struct ScalarQuat {
+    float w, x, y, z;
+};
+
+inline ScalarQuat ScalarQuatMultiply(const ScalarQuat& a, const ScalarQuat& b)
+{
+    ScalarQuat r;
+    r.w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z;
+    r.x = a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y;
+    r.y = a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x;
+    r.z = a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w;
+    return r;
+}
+
+inline ScalarQuat ScalarQuatNormalize(ScalarQuat q)
+{
+    float mag = sqrtf(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+    if (mag > 0.0f) {
+        float invMag = 1.0f / mag;
+        q.w *= invMag;
+        q.x *= invMag;
+        q.y *= invMag;
+        q.z *= invMag;
+    }
+    return q;
+}
+
+inline void ScalarQuatToMatrix(const ScalarQuat& q, float m[3][4])
+{
+    float xx = q.x * q.x;
+    float yy = q.y * q.y;
+    float zz = q.z * q.z;
+    float xy = q.x * q.y;
+    float xz = q.x * q.z;
+    float yz = q.y * q.z;
+    float wx = q.w * q.x;
+    float wy = q.w * q.y;
+    float wz = q.w * q.z;
+
+    m[0][0] = 1.0f - 2.0f * (yy + zz);
+    m[0][1] = 2.0f * (xy - wz);
+    m[0][2] = 2.0f * (xz + wy);
+    m[0][3] = 0.0f;
+
+    m[1][0] = 2.0f * (xy + wz);
+    m[1][1] = 1.0f - 2.0f * (xx + zz);
+    m[1][2] = 2.0f * (yz - wx);
+    m[1][3] = 0.0f;
+
+    m[2][0] = 2.0f * (xz - wy);
+    m[2][1] = 2.0f * (yz + wx);
+    m[2][2] = 1.0f - 2.0f * (xx + yy);
+    m[2][3] = 0.0f;
+}
+
+inline void ScalarMultiplyMatrices(const float a[3][4], const float b[3][4], float result[3][4])
+{
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 4; j++) {
+            result[i][j] = 0.0f;
+            for (int k = 0; k < 3; k++) {
+                result[i][j] += a[i][k] * b[k][j];
+            }
+            if (j == 3) {
+                result[i][j] += a[i][3];
+            }
+        }
+    }
+}
+
+inline void ScalarTransformPoint(const float m[3][4], const float* p, float* out)
+{
+    out[0] = m[0][0] * p[0] + m[0][1] * p[1] + m[0][2] * p[2] + m[0][3];
+    out[1] = m[1][0] * p[0] + m[1][1] * p[1] + m[1][2] * p[2] + m[1][3];
+    out[2] = m[2][0] * p[0] + m[2][1] * p[1] + m[2][2] * p[2] + m[2][3];
+}
+
+// Deterministic inputs in [-1, 1]
+class UniformFloats
+{
+public:
+    explicit UniformFloats(uint32_t seed) : m_state(seed) {}
+
+    float Next()
+    {
+        m_state = m_state * 1664525u + 1013904223u;
+        return (float)(m_state >> 8) * (2.0f / 16777216.0f) - 1.0f;
+    }
+
+private:
+    uint32_t m_state;
+};
+
+} // namespace FNVRTest
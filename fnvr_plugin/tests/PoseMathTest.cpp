@@ -0,0 +1,171 @@
+// fnvr_plugin/tests/PoseMathTest.cpp
+#include "PoseMath.h"
+#include "PoseMathScalar.h"
+#include "TestUtil.h"
+#include <cmath>
+
+// Each SSE kernel against the scalar code it replaced, over 200k random inputs.
+// Bounds are a few float ulps of the magnitudes involved: the kernels sum in a
+// different order, so results may differ in the last bits but no more.
+
+using namespace FNVR;
+using FNVRTest::ScalarQuat;
+
+namespace {
+
+const int kSamples = 200000;
+
+ScalarQuat RandomQuat(FNVRTest::UniformFloats& random)
+{
+    ScalarQuat q;
+    q.w = random.Next();
+    q.x = random.Next();
+    q.y = random.Next();
+    q.z = random.Next();
+    return q;
+}
+
+double QuatError(const ScalarQuat& expected, __m128 actual)
+{
+    float out[4];
+    StoreQuat(out, actual);
+    double error = fabs(out[0] - expected.w);
+    error = fmax(error, fabs(out[1] - expected.x));
+    error = fmax(error, fabs(out[2] - expected.y));
+    return fmax(error, fabs(out[3] - expected.z));
+}
+
+void TestQuatMultiply()
+{
+    FNVRTest::UniformFloats random(1);
+    double maxError = 0.0;
+    for (int i = 0; i < kSamples; i++) {
+        ScalarQuat a = RandomQuat(random);
+        ScalarQuat b = RandomQuat(random);
+        __m128 product = QuatMultiply(LoadQuat(&a.w), LoadQuat(&b.w));
+        maxError = fmax(maxError, QuatError(FNVRTest::ScalarQuatMultiply(a, b), product));
+    }
+    printf("  QuatMultiply    max error %.2g\n", maxError);
+    FNVR_CHECK(maxError <= 1e-6);  // |components| <= 4
+}
+
+void TestQuatNormalize()
+{
+    FNVRTest::UniformFloats random(2);
+    double maxError = 0.0;
+    for (int i = 0; i < kSamples; i++) {
+        ScalarQuat q = RandomQuat(random);
+        maxError = fmax(maxError, QuatError(FNVRTest::ScalarQuatNormalize(q), QuatNormalize(LoadQuat(&q.w))));
+    }
+    printf("  QuatNormalize   max error %.2g\n", maxError);
+    FNVR_CHECK(maxError <= 5e-7);
+
+    // A zero quaternion comes back unchanged, not NaN
+    float zero[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float out[4];
+    StoreQuat(out, QuatNormalize(LoadQuat(zero)));
+    FNVR_CHECK(out[0] == 0.0f && out[1] == 0.0f && out[2] == 0.0f && out[3] == 0.0f);
+}
+
+void TestQuatToRows()
+{
+    FNVRTest::UniformFloats random(3);
+    double maxError = 0.0;
+    for (int i = 0; i < kSamples; i++) {
+        ScalarQuat q = FNVRTest::ScalarQuatNormalize(RandomQuat(random));
+        float expected[3][4];
+        FNVRTest::ScalarQuatToMatrix(q, expected);
+
+        MatrixRows rows;
+        QuatToRows(LoadQuat(&q.w), rows);
+        float m34[12];
+        StoreRows34(m34, rows);
+        float m33[10];
+        m33[9] = 12345.0f;
+        StoreRows33(m33, rows);
+        FNVR_CHECK(m33[9] == 12345.0f);  // Never writes past m[8]
+
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 4; c++) {
+                maxError = fmax(maxError, fabs(m34[r * 4 + c] - expected[r][c]));
+            }
+            for (int c = 0; c < 3; c++) {
+                maxError = fmax(maxError, fabs(m33[r * 3 + c] - expected[r][c]));
+            }
+        }
+    }
+    printf("  QuatToRows      max error %.2g\n", maxError);
+    FNVR_CHECK(maxError <= 5e-7);
+}
+
+void RandomAffine(FNVRTest::UniformFloats& random, float m[3][4])
+{
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 4; c++) {
+            m[r][c] = random.Next() * 3.0f;
+        }
+    }
+}
+
+void TestComposeRows()
+{
+    FNVRTest::UniformFloats random(4);
+    double maxError = 0.0;
+    for (int i = 0; i < kSamples; i++) {
+        float a[3][4], b[3][4], expected[3][4];
+        RandomAffine(random, a);
+        RandomAffine(random, b);
+        FNVRTest::ScalarMultiplyMatrices(a, b, expected);
+
+        MatrixRows ra, rb;
+        LoadRows34(&a[0][0], ra);
+        LoadRows34(&b[0][0], rb);
+        ComposeRows(ra, rb, ra);  // out aliasing a, as VRManager calls it
+        float out[12];
+        StoreRows34(out, ra);
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 4; c++) {
+                maxError = fmax(maxError, fabs(out[r * 4 + c] - expected[r][c]));
+            }
+        }
+    }
+    printf("  ComposeRows     max error %.2g\n", maxError);
+    FNVR_CHECK(maxError <= 1e-5);  // |elements| <= 30
+}
+
+void TestTransformPoint()
+{
+    FNVRTest::UniformFloats random(5);
+    double maxError = 0.0;
+    for (int i = 0; i < kSamples; i++) {
+        float m[3][4];
+        RandomAffine(random, m);
+        float p[3] = { random.Next() * 100.0f, random.Next() * 100.0f, random.Next() * 100.0f };
+        float expected[3];
+        FNVRTest::ScalarTransformPoint(m, p, expected);
+
+        MatrixRows rows;
+        LoadRows34(&m[0][0], rows);
+        float out[4];
+        out[3] = 12345.0f;
+        TransformPoint(rows, p, out);
+        FNVR_CHECK(out[3] == 12345.0f);  // Writes three floats only
+        for (int c = 0; c < 3; c++) {
+            maxError = fmax(maxError, fabs(out[c] - expected[c]));
+        }
+    }
+    printf("  TransformPoint  max error %.2g\n", maxError);
+    FNVR_CHECK(maxError <= 2e-4);  // |result| <= 903
+}
+
+} // namespace
+
+int main()
+{
+    TestQuatMultiply();
+    TestQuatNormalize();
+    TestQuatToRows();
+    TestComposeRows();
+    TestTransformPoint();
+    return FNVRTest::Finish("PoseMathTest");
+}
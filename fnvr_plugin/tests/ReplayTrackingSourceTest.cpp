@@ -0,0 +1,110 @@
+// fnvr_plugin/tests/ReplayTrackingSourceTest.cpp
+#include "ReplayTrackingSource.h"
+#include "TestUtil.h"
+#include <cmath>
+#include <cstring>
+#include <unistd.h>
+
+// Seeking and looping over synthetic session recordings: 1000 V3 packets received
+// 1 ms apart, each stamped with its record number.
+
+namespace {
+
+const uint32_t kRecords = 1000;
+
+// withIndex = false leaves the file as a crashed recorder would (no index), so the
+// replay has to rebuild it by scanning
+std::string WriteSession(bool withIndex)
+{
+    char path[] = "/tmp/fnvr_replay_test_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        return std::string();
+    }
+    FILE* file = fdopen(fd, "wb");
+
+    FNVR::SessionFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = FNVR::SESSION_FILE_MAGIC;
+    header.version = FNVR::SESSION_FILE_VERSION;
+    header.headerSize = sizeof(header);
+    header.recordCount = kRecords;
+    fwrite(&header, sizeof(header), 1, file);
+
+    std::vector<FNVR::SessionIndexEntry> index;
+    uint64_t offset = sizeof(header);
+    for (uint32_t i = 0; i < kRecords; i++) {
+        VRDataPacketFlat flat;
+        memset(&flat, 0, sizeof(flat));
+        flat.hmd_qw = flat.left_qw = flat.right_qw = 1.0f;
+        flat.timestamp = i;
+        VRDataPacketV3 packet;
+        ConvertFlatToV3(flat, packet);
+
+        FNVR::SessionRecordHeader record = { i * 1000000ull, (uint16_t)sizeof(packet) };
+        if (i % FNVR::SESSION_INDEX_INTERVAL == 0) {
+            FNVR::SessionIndexEntry entry = { record.receiveTimeNs, offset };
+            index.push_back(entry);
+        }
+        fwrite(&record, sizeof(record), 1, file);
+        fwrite(&packet, sizeof(packet), 1, file);
+        offset += sizeof(record) + sizeof(packet);
+    }
+
+    if (withIndex) {
+        fwrite(&index[0], sizeof(index[0]), index.size(), file);
+        header.indexOffset = offset;
+        header.indexCount = (uint32_t)index.size();
+        fseek(file, 0, SEEK_SET);
+        fwrite(&header, sizeof(header), 1, file);
+    }
+    fclose(file);
+    return path;
+}
+
+double ReadTimestamp(ReplayTrackingSource& source)
+{
+    WirePacket packet;
+    return source.Read(packet) ? VRPacketView(packet).GetTimestamp() : -1.0;
+}
+
+void TestSeekAndLoop(bool withIndex)
+{
+    std::string path = WriteSession(withIndex);
+    FNVR_CHECK(!path.empty());
+
+    ReplayTrackingSource source(path, 0.0f, true);
+    FNVR_CHECK(source.Connect());
+    FNVR_CHECK(std::fabs(source.GetDurationSeconds() - (kRecords - 1) * 0.001) < 1e-9);
+    FNVR_CHECK(ReadTimestamp(source) == 0.0);
+
+    // First record received at or after 0.5005 s is record 501
+    FNVR_CHECK(source.SeekToTime(0.5005));
+    for (uint32_t i = 501; i < kRecords; i++) {
+        if (ReadTimestamp(source) != i) {
+            FNVR_CHECK(false);
+            break;
+        }
+    }
+    // Looping goes back to the seek target, not to the start of the file
+    FNVR_CHECK(ReadTimestamp(source) == 501.0);
+    FNVR_CHECK(ReadTimestamp(source) == 502.0);
+
+    // A start past the end of a non-looping replay just finishes it
+    ReplayTrackingSource pastEnd(path, 0.0f, false);
+    FNVR_CHECK(pastEnd.Connect());
+    FNVR_CHECK(pastEnd.SeekToTime(5.0));
+    FNVR_CHECK(ReadTimestamp(pastEnd) == -1.0);
+    FNVR_CHECK(!pastEnd.Connect());
+
+    unlink(path.c_str());
+}
+
+} // namespace
+
+int main()
+{
+    TestSeekAndLoop(true);
+    TestSeekAndLoop(false);
+    return FNVRTest::Finish("ReplayTrackingSourceTest");
+}
@@ -0,0 +1,72 @@
+// fnvr_plugin/tests/SharedMemoryBench.cpp
+#include "SharedMemoryClient.h"
+#include "TestUtil.h"
+#include <cstring>
+#include <unistd.h>
+
+// Per-sample transport cost: the shared-memory ring (SharedMemoryWriter ->
+// SharedMemoryClient::Read, POSIX shm_open backend) against a pipe carrying the same
+// packets (write + read, one packet per syscall as PipeClient does with ReadFile).
+// Writer and reader alternate on one thread, so every read finds a new sample and the
+// numbers are the transport's own cost, not scheduling.
+
+namespace {
+
+VRDataPacketV2 MakePacket()
+{
+    VRDataPacketV2 packet;
+    memset(&packet, 0, sizeof(packet));
+    packet.version = 2;
+    packet.flags = VR_FLAG_BASIC_DATA;
+    packet.hmd_qw = 1.0f;
+    packet.ctl_qw = 1.0f;
+    return packet;
+}
+
+} // namespace
+
+int main()
+{
+    const int iterations = 1000000;
+    VRDataPacketV2 packet = MakePacket();
+    WirePacket received;
+
+    SharedMemoryWriter writer("FNVRBench");
+    SharedMemoryClient client("FNVRBench");
+    if (!writer.Create() || !client.Connect()) {
+        printf("could not create the shared memory ring\n");
+        return 1;
+    }
+    int shmFailures = 0;
+    double shmNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        packet.timestamp = i;
+        writer.Write(&packet, sizeof(packet));
+        shmFailures += client.Read(received) ? 0 : 1;
+    });
+    client.Disconnect();
+    writer.Close();
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        printf("could not create a pipe\n");
+        return 1;
+    }
+    int pipeFailures = 0;
+    double pipeNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        packet.timestamp = i;
+        bool ok = write(fds[1], &packet, sizeof(packet)) == (ssize_t)sizeof(packet) &&
+            read(fds[0], received.data, sizeof(packet)) == (ssize_t)sizeof(packet);
+        pipeFailures += ok ? 0 : 1;
+    });
+    close(fds[0]);
+    close(fds[1]);
+
+    printf("write + read of one %u-byte V2 packet\n", (unsigned)sizeof(packet));
+    printf("  shared memory ring  %7.1f ns\n", shmNs);
+    printf("  pipe                %7.1f ns\n", pipeNs);
+    if (shmFailures || pipeFailures) {
+        printf("failed reads: shared memory %d, pipe %d\n", shmFailures, pipeFailures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+// fnvr_plugin/tests/SharedMemoryClientTest.cpp
+#include "SharedMemoryClient.h"
+#include "TestUtil.h"
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+// SharedMemoryClient against the POSIX backend: a waiting Read() wakes on the writer's
+// signal, a writer that stays quiet for longer than a second is still waited for, and
+// a writer that closes the ring or dies ends the Read() with a disconnect.
+
+namespace {
+
+const char* const kMapping = "FNVRClientTest";
+
+VRDataPacketV2 MakePacket(double timestamp)
+{
+    VRDataPacketV2 packet;
+    memset(&packet, 0, sizeof(packet));
+    packet.version = 2;
+    packet.hmd_qw = packet.ctl_qw = 1.0f;
+    packet.timestamp = timestamp;
+    return packet;
+}
+
+double ReadTimestamp(const WirePacket& packet)
+{
+    VRDataPacketV2 v2;
+    memcpy(&v2, packet.data, sizeof(v2));
+    return v2.timestamp;
+}
+
+void TestQuietWriter()
+{
+    SharedMemoryWriter writer(kMapping);
+    FNVR_CHECK(writer.Create());
+    SharedMemoryClient client(kMapping);
+    FNVR_CHECK(client.Connect());
+    std::atomic<bool> stop(false);
+    client.SetStopFlag(&stop);
+
+    // Quiet for 1.5 s, then one packet: Read() waits it out and wakes promptly
+    double sent = 0.0;
+    std::thread writerThread([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+        VRDataPacketV2 packet = MakePacket(1.0);
+        sent = FNVRTest::Seconds();
+        writer.Write(&packet, sizeof(packet));
+    });
+    WirePacket packet;
+    bool read = client.Read(packet);
+    double wake = FNVRTest::Seconds() - sent;
+    writerThread.join();
+    FNVR_CHECK(read && ReadTimestamp(packet) == 1.0);
+    FNVR_CHECK(client.IsConnected());
+    printf("  woke %.3f ms after the write\n", wake * 1e3);
+    FNVR_CHECK(wake < 0.05);
+
+    // The writer closes the ring: a waiting Read() ends and disconnects
+    std::thread closer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        writer.Close();
+    });
+    double start = FNVRTest::Seconds();
+    FNVR_CHECK(!client.Read(packet));
+    closer.join();
+    FNVR_CHECK(!client.IsConnected());
+    FNVR_CHECK(FNVRTest::Seconds() - start < 1.0);
+}
+
+void TestDeadWriter()
+{
+    // A writer process that exits without closing the ring
+    int toChild[2];
+    int fromChild[2];
+    FNVR_CHECK(pipe(toChild) == 0 && pipe(fromChild) == 0);
+    pid_t child = fork();
+    if (child == 0) {
+        SharedMemoryWriter writer(kMapping);
+        char byte = writer.Create() ? 1 : 0;
+        (void)!write(fromChild[1], &byte, 1);
+        (void)!read(toChild[0], &byte, 1);
+        _exit(0);  // No Close(): the header still names this process
+    }
+    char ready = 0;
+    FNVR_CHECK(read(fromChild[0], &ready, 1) == 1 && ready == 1);
+
+    SharedMemoryClient client(kMapping);
+    FNVR_CHECK(client.Connect());
+    (void)!write(toChild[1], &ready, 1);
+    waitpid(child, nullptr, 0);
+
+    WirePacket packet;
+    double start = FNVRTest::Seconds();
+    FNVR_CHECK(!client.Read(packet));
+    FNVR_CHECK(!client.IsConnected());
+    FNVR_CHECK(FNVRTest::Seconds() - start < 1.0);
+
+    shm_unlink((std::string("/") + kMapping).c_str());
+    close(toChild[0]);
+    close(toChild[1]);
+    close(fromChild[0]);
+    close(fromChild[1]);
+}
+
+} // namespace
+
+int main()
+{
+    TestQuietWriter();
+    TestDeadWriter();
+    return FNVRTest::Finish("SharedMemoryClientTest");
+}
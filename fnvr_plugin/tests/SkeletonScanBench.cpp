@@ -0,0 +1,59 @@
+// fnvr_plugin/tests/SkeletonScanBench.cpp
+#include "SkeletonScan.h"
+#include "SyntheticSkeleton.h"
+#include "TestUtil.h"
+
+// Cost of building the NVCS bone cache on the synthetic skeleton: one FindBone per
+// bone (what BuildBoneCache did), against one ScanSkeleton pass by name and by
+// interned pointer.
+
+using namespace FNVR;
+using FNVRTest::SkeletonNode;
+using FNVRTest::SkeletonNodeTraits;
+
+int main()
+{
+    FNVRTest::SyntheticSkeleton skeleton;
+    const char* const* names = FNVRTest::kNVCSBoneNames;
+    const int count = FNVRTest::kNVCSBoneCount;
+
+    BoneNameTable byName;
+    BoneNameTable interned;
+    if (!byName.Build(names, count) || !interned.Build(names, count)) {
+        printf("could not build the bone name tables\n");
+        return 1;
+    }
+    for (int i = 0; i < count; i++) {
+        if (skeleton.Interned(names[i])) {
+            interned.SetInterned(i, skeleton.Interned(names[i]));
+        }
+    }
+
+    SkeletonNode* nodes[BoneNameTable::kMaxNames];
+    const int iterations = 20000;
+
+    double perNameNs = FNVRTest::NsPerCall(iterations, [&](int) {
+        for (int i = 0; i < count; i++) {
+            nodes[i] = FNVRTest::FindBone(skeleton.GetRoot(), names[i]);
+        }
+        FNVRTest::KeepAlive(nodes);
+    });
+
+    double byNameNs = FNVRTest::NsPerCall(iterations, [&](int) {
+        int found = ScanSkeleton<SkeletonNodeTraits>(skeleton.GetRoot(), byName, nodes);
+        FNVRTest::KeepAlive(found);
+    });
+
+    // The pointer pass alone (expectedFound 0), as a rebuild costs when every bone is
+    // found by pointer; "BIP01" here is not, so the full call would add the no-case pass
+    double internedNs = FNVRTest::NsPerCall(iterations, [&](int) {
+        int found = ScanSkeleton<SkeletonNodeTraits>(skeleton.GetRoot(), interned, nodes, 0);
+        FNVRTest::KeepAlive(found);
+    });
+
+    printf("NVCS bone cache build, %d bones, %d nodes\n", count, (int)skeleton.GetNodeCount());
+    printf("  FindBone per bone        %8.2f us\n", perNameNs / 1000.0);
+    printf("  one pass by name         %8.2f us\n", byNameNs / 1000.0);
+    printf("  one pass by pointer      %8.2f us\n", internedNs / 1000.0);
+    return 0;
+}
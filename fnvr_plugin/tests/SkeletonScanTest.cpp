@@ -0,0 +1,114 @@
+// fnvr_plugin/tests/SkeletonScanTest.cpp
+#include "SkeletonScan.h"
+#include "SyntheticSkeleton.h"
+#include "TestUtil.h"
+
+// ScanSkeleton must resolve every bone to the node the per-name search (FindBone)
+// finds, with and without interned names, for the NVCS and the FRIK name tables.
+
+using namespace FNVR;
+using FNVRTest::SkeletonNode;
+using FNVRTest::SkeletonNodeTraits;
+
+namespace {
+
+void CheckMatchesPerNameSearch(const FNVRTest::SyntheticSkeleton& skeleton, const char* const* names,
+                               int count, bool interned)
+{
+    BoneNameTable table;
+    FNVR_CHECK(table.Build(names, count));
+    if (interned) {
+        for (int i = 0; i < count; i++) {
+            if (names[i] && skeleton.Interned(names[i])) {
+                table.SetInterned(i, skeleton.Interned(names[i]));
+            }
+        }
+        FNVR_CHECK(table.HasInterned());
+    }
+
+    SkeletonNode* nodes[BoneNameTable::kMaxNames];
+    int found = ScanSkeleton<SkeletonNodeTraits>(skeleton.GetRoot(), table, nodes);
+
+    int expectedFound = 0;
+    for (int i = 0; i < count; i++) {
+        SkeletonNode* expected = names[i] ? FNVRTest::FindBone(skeleton.GetRoot(), names[i]) : nullptr;
+        if (nodes[i] != expected) {
+            printf("  %s: bone %d (%s) differs from the per-name search\n",
+                   interned ? "interned" : "by name", i, names[i] ? names[i] : "nullptr");
+        }
+        FNVR_CHECK(nodes[i] == expected);
+        expectedFound += expected ? 1 : 0;
+    }
+    FNVR_CHECK(found == expectedFound);
+}
+
+void TestNVCSBones()
+{
+    FNVRTest::SyntheticSkeleton skeleton;
+    CheckMatchesPerNameSearch(skeleton, FNVRTest::kNVCSBoneNames, FNVRTest::kNVCSBoneCount, false);
+    CheckMatchesPerNameSearch(skeleton, FNVRTest::kNVCSBoneNames, FNVRTest::kNVCSBoneCount, true);
+}
+
+void TestFRIKBones()
+{
+    FNVRTest::SyntheticSkeleton skeleton;
+    CheckMatchesPerNameSearch(skeleton, kFRIKBoneNames, kFRIKBoneCount, false);
+    CheckMatchesPerNameSearch(skeleton, kFRIKBoneNames, kFRIKBoneCount, true);
+}
+
+void TestDepthFirstOrder()
+{
+    // The armor's "Bip01 Head" comes after the skeleton's in depth-first order
+    FNVRTest::SyntheticSkeleton skeleton;
+    const char* names[] = { "Bip01 Head" };
+    BoneNameTable table;
+    FNVR_CHECK(table.Build(names, 1));
+    SkeletonNode* node = nullptr;
+    FNVR_CHECK(ScanSkeleton<SkeletonNodeTraits>(skeleton.GetRoot(), table, &node) == 1);
+    FNVR_CHECK(node && node->children.size() == 11);  // Camera1st and the ten HeadAnims
+}
+
+void TestInternedFallback()
+{
+    // "BIP01" only matches "Bip01" without case; with expectedFound at what the pointer
+    // pass finds, the fallback pass is skipped and the root bone stays missing
+    FNVRTest::SyntheticSkeleton skeleton;
+    BoneNameTable table;
+    FNVR_CHECK(table.Build(FNVRTest::kNVCSBoneNames, FNVRTest::kNVCSBoneCount));
+    for (int i = 0; i < FNVRTest::kNVCSBoneCount; i++) {
+        if (skeleton.Interned(FNVRTest::kNVCSBoneNames[i])) {
+            table.SetInterned(i, skeleton.Interned(FNVRTest::kNVCSBoneNames[i]));
+        }
+    }
+
+    SkeletonNode* nodes[BoneNameTable::kMaxNames];
+    int full = ScanSkeleton<SkeletonNodeTraits>(skeleton.GetRoot(), table, nodes);
+    FNVR_CHECK(full == FNVRTest::kNVCSBoneCount);
+    FNVR_CHECK(nodes[0] && nodes[0] == FNVRTest::FindBone(skeleton.GetRoot(), "Bip01"));
+
+    int quick = ScanSkeleton<SkeletonNodeTraits>(skeleton.GetRoot(), table, nodes, full - 1);
+    FNVR_CHECK(quick == full - 1);
+    FNVR_CHECK(nodes[0] == nullptr);
+}
+
+void TestNoRoot()
+{
+    BoneNameTable table;
+    FNVR_CHECK(table.Build(FNVRTest::kNVCSBoneNames, FNVRTest::kNVCSBoneCount));
+    SkeletonNode* nodes[BoneNameTable::kMaxNames];
+    nodes[3] = reinterpret_cast<SkeletonNode*>(&table);
+    FNVR_CHECK(ScanSkeleton<SkeletonNodeTraits>((SkeletonNode*)nullptr, table, nodes) == 0);
+    FNVR_CHECK(nodes[3] == nullptr);
+}
+
+} // namespace
+
+int main()
+{
+    TestNVCSBones();
+    TestFRIKBones();
+    TestDepthFirstOrder();
+    TestInternedFallback();
+    TestNoRoot();
+    return FNVRTest::Finish("SkeletonScanTest");
+}
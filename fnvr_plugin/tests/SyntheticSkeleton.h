@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <set>
+#include <string>
+#include <strings.h>
+#include <vector>
+
+// A node tree shaped like the player's NVCS skeleton for the SkeletonScan test and
+// benchmark: the Bip01 hierarchy with fingers, weapon parts, head animation nodes and
+// armor nodes hung off the root. Names are interned in a pool, as NiFixedString is.
+
+namespace FNVRTest {
+
+struct SkeletonNode {
+    const char* name;
+    std::vector<SkeletonNode*> children;
+};
+
+struct SkeletonNodeTraits {
+    static const char* Name(SkeletonNode* node) { return node->name; }
+    static uint32_t ChildCount(SkeletonNode* node) { return (uint32_t)node->children.size(); }
+    static SkeletonNode* Child(SkeletonNode* node, uint32_t i) { return node->children[i]; }
+};
+
+// NVCSSkeleton::GetBoneName order
+const char* const kNVCSBoneNames[] = {
+    "Bip01", "Bip01 NonAccum", "Bip01 Pelvis",
+    "Bip01 Spine", "Bip01 Spine1", "Bip01 Spine2",
+    "Bip01 Neck", "Bip01 Neck1", "Bip01 Head",
+    "Bip01 R Clavicle", "Bip01 R UpperArm", "Bip01 R Forearm", "Bip01 R Hand",
+    "Bip01 L Clavicle", "Bip01 L UpperArm", "Bip01 L Forearm", "Bip01 L Hand",
+    "Bip01 R Finger0", "Bip01 R Finger01", "Bip01 R Finger02",
+    "Bip01 R Finger1", "Bip01 R Finger11", "Bip01 R Finger12",
+    "Weapon", "Weapon2", "Camera1st",
+    "Bip01 L Thigh", "Bip01 L Calf", "Bip01 L Foot",
+    "Bip01 R Thigh", "Bip01 R Calf", "Bip01 R Foot"
+};
+const int kNVCSBoneCount = sizeof(kNVCSBoneNames) / sizeof(kNVCSBoneNames[0]);
+
+class SyntheticSkeleton
+{
+public:
+    SyntheticSkeleton()
+    {
+        m_root = Add("Scene Root", nullptr);
+        SkeletonNode* bip = Add("BIP01", m_root);  // Differs in case: only the no-case pass finds it
+        SkeletonNode* pelvis = Add("Bip01 Pelvis", Add("Bip01 NonAccum", bip));
+        SkeletonNode* spine2 = Add("Bip01 Spine2", Add("Bip01 Spine1", Add("Bip01 Spine", pelvis)));
+        SkeletonNode* head = Add("Bip01 Head", Add("Bip01 Neck1", Add("Bip01 Neck", spine2)));
+        Add("Camera1st", head);
+        for (int i = 0; i < 10; i++) {
+            Add(Format("HeadAnims%d", i), head);
+        }
+
+        // Format reuses one buffer, so formatted names are added one statement at a time
+        const char* sides[] = { "R", "L" };
+        for (const char* side : sides) {
+            SkeletonNode* arm = Add(Format("Bip01 %s Clavicle", side), spine2);
+            arm = Add(Format("Bip01 %s UpperArm", side), arm);
+            arm = Add(Format("Bip01 %s Forearm", side), arm);
+            SkeletonNode* hand = Add(Format("Bip01 %s Hand", side), arm);
+            for (int finger = 0; finger < 5; finger++) {
+                SkeletonNode* joint = Add(Format("Bip01 %s Finger%d", side, finger), hand);
+                joint = Add(Format("Bip01 %s Finger%d1", side, finger), joint);
+                Add(Format("Bip01 %s Finger%d2", side, finger), joint);
+            }
+            if (side[0] == 'R') {
+                SkeletonNode* weapon = Add("Weapon", hand);
+                for (int i = 0; i < 15; i++) {
+                    Add(Format("WeaponPart%d", i), weapon);
+                }
+            } else {
+                Add("Weapon2", hand);
+            }
+            SkeletonNode* leg = Add(Format("Bip01 %s Thigh", side), pelvis);
+            leg = Add(Format("Bip01 %s Calf", side), leg);
+            leg = Add(Format("Bip01 %s Foot", side), leg);
+            Add(Format("Bip01 %s Toe0", side), leg);
+        }
+
+        // Armor hung off the root after the skeleton, one with a second "Bip01 Head":
+        // depth-first order must still pick the skeleton's
+        for (int i = 0; i < 40; i++) {
+            SkeletonNode* armor = Add(Format("Armor:%d", i), m_root);
+            if (i == 20) {
+                Add("Bip01 Head", armor);
+            }
+        }
+    }
+
+    SkeletonNode* GetRoot() const { return m_root; }
+    size_t GetNodeCount() const { return m_nodes.size(); }
+
+    // The pool's copy of name, or nullptr if no node is called exactly that
+    const char* Interned(const char* name) const
+    {
+        std::set<std::string>::const_iterator it = m_names.find(name);
+        return it != m_names.end() ? it->c_str() : nullptr;
+    }
+
+private:
+    const char* Format(const char* format, const char* side, int n = 0)
+    {
+        snprintf(m_buffer, sizeof(m_buffer), format, side, n);
+        return m_buffer;
+    }
+    const char* Format(const char* format, int n)
+    {
+        snprintf(m_buffer, sizeof(m_buffer), format, n);
+        return m_buffer;
+    }
+
+    SkeletonNode* Add(const char* name, SkeletonNode* parent)
+    {
+        m_nodes.emplace_back(new SkeletonNode());
+        SkeletonNode* node = m_nodes.back().get();
+        node->name = m_names.insert(name).first->c_str();
+        if (parent) {
+            parent->children.push_back(node);
+        }
+        return node;
+    }
+
+    SkeletonNode* m_root;
+    std::vector<std::unique_ptr<SkeletonNode>> m_nodes;
+    std::set<std::string> m_names;
+    char m_buffer[64];
+};
+
+// The per-name search the scan replaced (FindBone): depth-first, case-insensitive
+inline SkeletonNode* FindBone(SkeletonNode* node, const char* name)
+{
+    if (node->name && strcasecmp(node->name, name) == 0) {
+        return node;
+    }
+    for (SkeletonNode* child : node->children) {
+        SkeletonNode* found = FindBone(child, name);
+        if (found) {
+            return found;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace FNVRTest
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+// Shared helpers for the Linux tests and benchmarks (tests/CMakeLists.txt).
+// Tests count failed checks and return that count from main(), so ctest sees non-zero.
+
+namespace FNVRTest {
+
+inline int& Failures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+inline int Finish(const char* name)
+{
+    if (Failures() == 0) {
+        printf("%s: ok\n", name);
+    } else {
+        printf("%s: %d check(s) failed\n", name, Failures());
+    }
+    return Failures();
+}
+
+// Keeps a computed value alive so the optimizer cannot drop the work behind it
+template <typename T>
+inline void KeepAlive(const T& value)
+{
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+inline double Seconds()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Nanoseconds per call of fn(i), best of five runs of iterations calls
+template <typename Fn>
+double NsPerCall(int iterations, Fn fn)
+{
+    double best = 1e30;
+    for (int run = 0; run < 5; run++) {
+        double start = Seconds();
+        for (int i = 0; i < iterations; i++) {
+            fn(i);
+        }
+        double ns = (Seconds() - start) * 1e9 / iterations;
+        if (ns < best) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+} // namespace FNVRTest
+
+// Records a failure with its location and keeps going
+#define FNVR_CHECK(cond)                                                          \
+    do {                                                                          \
+        if (!(cond)) {                                                            \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);       \
+            FNVRTest::Failures()++;                                               \
+        }                                                                         \
+    } while (0)
@@ -0,0 +1,302 @@
+// fnvr_plugin/tests/TrackingLoadTest.cpp
+#include "UdpTrackingSource.h"
+#include "SharedMemoryClient.h"
+#include "ReplayTrackingSource.h"
+#include "PoseMailbox.h"
+#include "PoseJitterBuffer.h"
+#include "LatencyStats.h"
+#include "TestUtil.h"
+#include <arpa/inet.h>
+#include <cstring>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+// Drives each POSIX tracking source at 1 kHz and above through the same
+// decode -> validate -> publish steps as RunTrackerLoop (PluginMain.cpp): read into
+// the mailbox slot, view, validate, clock sync, jitter buffer, publish. Checks that
+// nothing arrives out of order, invalid packets are never published, and the newest
+// packet always gets through; prints the rates and send-to-publish latency.
+
+namespace {
+
+const uint16_t kUdpPort = 49190;
+
+struct IngestResult {
+    uint32_t published = 0;
+    uint32_t outOfOrder = 0;
+    double lastTimestamp = -1.0;
+    double seconds = 0.0;    // First to last publish
+    double publishNs = 0.0;  // Mean cost of view + validate + publish
+    FNVR::LatencyHistogram latency;  // Send -> publish, for monotonic-stamped packets
+};
+
+// RunTrackerLoop's read path without the logging. Runs until `stop` is set, `count`
+// packets were published, or the source cannot reconnect (a finished replay).
+void Ingest(ITrackingSource& source, const std::atomic<bool>& stop, uint32_t count, IngestResult& result)
+{
+    FNVR::PoseMailbox<WirePacket> mailbox;
+    FNVR::PoseJitterBuffer jitterBuffer;
+    FNVR::ClockSync clockSync;
+    source.SetStopFlag(&stop);
+
+    double publishSeconds = 0.0;
+    int connectFailures = 0;
+    double firstPublish = 0.0, lastPublish = 0.0;
+    while (!stop && result.published < count) {
+        if (!source.IsConnected() && !source.Connect()) {
+            if (++connectFailures > 200) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        WirePacket& data = mailbox.BeginWrite();
+        if (!source.Read(data)) {
+            if (!stop) {
+                source.Disconnect();
+            }
+            continue;
+        }
+
+        double publishStart = FNVRTest::Seconds();
+        VRPacketView view(data);
+        if (IsTrackingPacketValid(view)) {
+            clockSync.AddSample(view.GetTimestamp(), view.HasMonotonicTimestamp());
+            jitterBuffer.Push(view);
+            mailbox.Publish();
+            if (view.GetTimestamp() <= result.lastTimestamp) {
+                result.outOfOrder++;
+            }
+            result.lastTimestamp = view.GetTimestamp();
+            result.published++;
+            lastPublish = FNVRTest::Seconds();
+            if (result.published == 1) {
+                firstPublish = lastPublish;
+            }
+            if (view.HasMonotonicTimestamp()) {
+                result.latency.Record(FNVR::ClockSync::MonotonicNow() - view.GetTimestamp());
+            }
+        }
+        publishSeconds += FNVRTest::Seconds() - publishStart;
+    }
+    result.seconds = lastPublish - firstPublish;
+    result.publishNs = result.published ? publishSeconds * 1e9 / result.published : 0.0;
+}
+
+VRDataPacketV3 MakePacket(double timestamp, bool monotonic)
+{
+    VRDataPacketFlat flat;
+    memset(&flat, 0, sizeof(flat));
+    flat.hmd_qw = flat.left_qw = flat.right_qw = 1.0f;
+    flat.right_px = 0.3f;
+    flat.flags = monotonic ? VR_FLAG_MONOTONIC_TIME : 0;
+    flat.timestamp = timestamp;
+    VRDataPacketV3 packet;
+    ConvertFlatToV3(flat, packet);
+    return packet;
+}
+
+// Sends `count` packets at `rateHz` from another thread via `send`, stamping each with
+// the monotonic clock; a stray 3-byte datagram and a packet with a bad HMD quaternion
+// go in halfway and must not be published. Returns the last valid timestamp sent.
+template <typename Send, typename SendRaw>
+double RunPacedSender(uint32_t count, double rateHz, Send send, SendRaw sendRaw)
+{
+    double last = 0.0;
+    double next = FNVRTest::Seconds();
+    for (uint32_t i = 0; i < count; i++) {
+        if (i == count / 2) {
+            const unsigned char junk[3] = { 9, 9, 9 };
+            sendRaw(junk, sizeof(junk));
+            VRDataPacketV3 bad = MakePacket(FNVR::ClockSync::MonotonicNow(), true);
+            bad.hmd.q[0] = bad.hmd.q[1] = bad.hmd.q[2] = 30000;  // |q| well above 1
+            sendRaw(&bad, sizeof(bad));
+        }
+        last = FNVR::ClockSync::MonotonicNow();
+        VRDataPacketV3 packet = MakePacket(last, true);
+        send(packet);
+
+        next += 1.0 / rateHz;
+        double wait = next - FNVRTest::Seconds();
+        if (wait > 0.0) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+        }
+    }
+    return last;
+}
+
+void Report(const char* name, const IngestResult& result, uint32_t dropped)
+{
+    char latency[256];
+    result.latency.FormatSummary(latency, sizeof(latency));
+    printf("%-26s %6u published %5u skipped  %7.0f Hz  publish %5.0f ns  latency %s\n", name,
+           result.published, dropped, result.published / result.seconds, result.publishNs,
+           result.latency.GetCount() ? latency : "-");
+}
+
+void TestUdp()
+{
+    const uint32_t count = 2000;
+    UdpTrackingSource source(kUdpPort);
+    FNVR_CHECK(source.Connect());
+
+    std::atomic<bool> stop(false);
+    IngestResult result;
+    double lastSent = 0.0;
+    std::thread sender([&] {
+        int s = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(kUdpPort);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        auto sendRaw = [&](const void* data, size_t size) {
+            sendto(s, data, size, 0, (const sockaddr*)&addr, sizeof(addr));
+        };
+        lastSent = RunPacedSender(count, 2000.0,
+            [&](const VRDataPacketV3& packet) { sendRaw(&packet, sizeof(packet)); }, sendRaw);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        stop = true;
+        close(s);
+    });
+    Ingest(source, stop, count, result);
+    sender.join();
+
+    Report("UDP, 2 kHz sender", result, source.GetDroppedPackets());
+    FNVR_CHECK(result.outOfOrder == 0);
+    FNVR_CHECK(result.lastTimestamp == lastSent);
+    // Every valid datagram is either published or skipped by a latest-wins read
+    FNVR_CHECK(result.published + source.GetDroppedPackets() >= count);
+}
+
+// Datagrams already queued when Read() is called: it returns the newest valid packet
+// and never lets a stray datagram behind it displace it
+void TestUdpStrayAfterValid()
+{
+    UdpTrackingSource source(kUdpPort);
+    FNVR_CHECK(source.Connect());
+    std::atomic<bool> stop(false);
+    source.SetStopFlag(&stop);
+    std::thread watchdog([&] {
+        // A Read() that lost its packet blocks until stopped
+        for (int i = 0; i < 200 && !stop; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        stop = true;
+    });
+
+    int s = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(kUdpPort);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    auto sendRaw = [&](const void* data, size_t size) {
+        sendto(s, data, size, 0, (const sockaddr*)&addr, sizeof(addr));
+    };
+    const unsigned char junk[3] = { 9, 9, 9 };
+    VRDataPacketV3 first = MakePacket(1.0, false);
+    VRDataPacketV3 second = MakePacket(2.0, false);
+
+    // Valid, then stray: the valid one is returned
+    sendRaw(&first, sizeof(first));
+    sendRaw(junk, sizeof(junk));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    WirePacket packet;
+    FNVR_CHECK(source.Read(packet) && VRPacketView(packet).GetTimestamp() == 1.0);
+
+    // Stray, valid, valid, stray: the newest valid one, the older one counted as dropped
+    sendRaw(junk, sizeof(junk));
+    sendRaw(&first, sizeof(first));
+    sendRaw(&second, sizeof(second));
+    sendRaw(junk, sizeof(junk));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    FNVR_CHECK(source.Read(packet) && VRPacketView(packet).GetTimestamp() == 2.0);
+    FNVR_CHECK(source.GetDroppedPackets() == 1);
+
+    stop = true;
+    watchdog.join();
+    close(s);
+    source.Disconnect();
+}
+
+void TestSharedMemory()
+{
+    const uint32_t count = 2000;
+    SharedMemoryWriter writer("FNVRLoadTest");
+    FNVR_CHECK(writer.Create());
+    SharedMemoryClient source("FNVRLoadTest");
+
+    std::atomic<bool> stop(false);
+    IngestResult result;
+    double lastSent = 0.0;
+    std::thread sender([&] {
+        lastSent = RunPacedSender(count, 2000.0,
+            [&](const VRDataPacketV3& packet) { writer.Write(&packet, sizeof(packet)); },
+            [&](const void* data, size_t size) { writer.Write(data, (uint32_t)size); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        stop = true;
+    });
+    Ingest(source, stop, count, result);
+    sender.join();
+
+    Report("shared memory, 2 kHz", result, source.GetDroppedPackets());
+    FNVR_CHECK(result.outOfOrder == 0);
+    FNVR_CHECK(result.lastTimestamp == lastSent);
+    FNVR_CHECK(result.published + source.GetDroppedPackets() >= count);
+}
+
+// Raw V3 capture with 1 ms timestamps, replayed as fast as possible and in real time
+void TestReplay()
+{
+    char path[] = "/tmp/fnvr_load_test_XXXXXX";
+    int fd = mkstemp(path);
+    FNVR_CHECK(fd >= 0);
+    if (fd < 0) {
+        return;
+    }
+    const uint32_t count = 100000;
+    for (uint32_t i = 0; i < count; i++) {
+        VRDataPacketV3 packet = MakePacket(i * 0.001, false);
+        if (write(fd, &packet, sizeof(packet)) != (ssize_t)sizeof(packet)) {
+            FNVR_CHECK(false);
+            break;
+        }
+    }
+    close(fd);
+
+    std::atomic<bool> stop(false);
+    {
+        ReplayTrackingSource source(path, 0.0f, false);
+        IngestResult result;
+        Ingest(source, stop, count + 1, result);
+        Report("replay, max speed", result, 0);
+        FNVR_CHECK(result.published == count);
+        FNVR_CHECK(result.outOfOrder == 0);
+        FNVR_CHECK(result.lastTimestamp == (count - 1) * 0.001);
+        FNVR_CHECK(!source.Connect());  // Finished and not looping
+    }
+    {
+        const uint32_t paced = 1000;
+        ReplayTrackingSource source(path, 1.0f, false);
+        IngestResult result;
+        Ingest(source, stop, paced, result);
+        Report("replay, 1 kHz real time", result, 0);
+        FNVR_CHECK(result.published == paced);
+        FNVR_CHECK(result.outOfOrder == 0);
+        // 999 ms of recorded time, played back on schedule
+        FNVR_CHECK(result.seconds > 0.95 && result.seconds < 1.2);
+    }
+    unlink(path);
+}
+
+} // namespace
+
+int main()
+{
+    TestUdp();
+    TestUdpStrayAfterValid();
+    TestSharedMemory();
+    TestReplay();
+    return FNVRTest::Finish("TrackingLoadTest");
+}
@@ -0,0 +1,181 @@
+// fnvr_plugin/tests/VRDataPacketV3Test.cpp
+#include "VRDataPacket.h"
+#include "TestUtil.h"
+#include <cmath>
+#include <cstring>
+#include <random>
+
+// Round trip through the V3 codec (ConvertFlatToV3 -> ConvertV3ToFlat) against the
+// precision documented in VRDataPacketV3.h: about 0.004 degrees of rotation and
+// 0.5 mm of position per device.
+
+namespace {
+
+const double kMaxRotationErrorDeg = 0.004;
+// 0.5 mm of rounding plus the float spacing of the largest coordinate tested (32 m)
+const double kMaxPositionErrorM = VR3_POSITION_ERROR_M + 4e-6;
+
+// Angle of the rotation between two unit quaternions (w, x, y, z), in degrees
+double RotationErrorDeg(const float a[4], const float b[4])
+{
+    // Vector part of conj(a) * b; its length is sin(angle / 2), which is well
+    // conditioned for small angles unlike acos of the dot product
+    double aw = a[0], ax = -a[1], ay = -a[2], az = -a[3];
+    double x = aw * b[1] + ax * b[0] + ay * b[3] - az * b[2];
+    double y = aw * b[2] - ax * b[3] + ay * b[0] + az * b[1];
+    double z = aw * b[3] + ax * b[2] - ay * b[1] + az * b[0];
+    double s = std::sqrt(x * x + y * y + z * z);
+    return 2.0 * std::asin(s < 1.0 ? s : 1.0) * 180.0 / 3.14159265358979323846;
+}
+
+void SetPose(float* q, float* p, const double rq[4], const double rp[3])
+{
+    for (int i = 0; i < 4; i++) q[i] = (float)rq[i];
+    for (int i = 0; i < 3; i++) p[i] = (float)rp[i];
+}
+
+struct RoundTrip {
+    double rotationDeg = 0.0;
+    double positionM = 0.0;
+};
+
+// Encodes one pose per device and checks all three back
+void CheckPoses(const double q[3][4], const double p[3][3], RoundTrip& worst)
+{
+    VRDataPacketFlat in;
+    memset(&in, 0, sizeof(in));
+    SetPose(&in.hmd_qw, &in.hmd_px, q[0], p[0]);
+    SetPose(&in.left_qw, &in.left_px, q[1], p[1]);
+    SetPose(&in.right_qw, &in.right_px, q[2], p[2]);
+
+    VRDataPacketV3 wire;
+    ConvertFlatToV3(in, wire);
+    VRDataPacketFlat out;
+    memset(&out, 0, sizeof(out));
+    ConvertV3ToFlat(wire, out);
+
+    const float* inQ[3] = { &in.hmd_qw, &in.left_qw, &in.right_qw };
+    const float* outQ[3] = { &out.hmd_qw, &out.left_qw, &out.right_qw };
+    const float* inP[3] = { &in.hmd_px, &in.left_px, &in.right_px };
+    const float* outP[3] = { &out.hmd_px, &out.left_px, &out.right_px };
+    for (int d = 0; d < 3; d++) {
+        double rotation = RotationErrorDeg(inQ[d], outQ[d]);
+        if (rotation > worst.rotationDeg) worst.rotationDeg = rotation;
+        for (int i = 0; i < 3; i++) {
+            double position = std::fabs((double)inP[d][i] - outP[d][i]);
+            if (position > worst.positionM) worst.positionM = position;
+        }
+    }
+}
+
+// Uniform random rotations and positions within +/-32 m
+void TestRandomPoses()
+{
+    std::mt19937 rng(12345);
+    std::normal_distribution<double> normal;
+    std::uniform_real_distribution<double> coordinate(-32.0, 32.0);
+
+    RoundTrip worst;
+    const int packets = 350000;  // Three devices each: ~1M poses
+    for (int n = 0; n < packets; n++) {
+        double q[3][4], p[3][3];
+        for (int d = 0; d < 3; d++) {
+            double length = 0.0;
+            for (int i = 0; i < 4; i++) {
+                q[d][i] = normal(rng);
+                length += q[d][i] * q[d][i];
+            }
+            length = std::sqrt(length);
+            for (int i = 0; i < 4; i++) q[d][i] /= length;
+            for (int i = 0; i < 3; i++) p[d][i] = coordinate(rng);
+        }
+        CheckPoses(q, p, worst);
+    }
+
+    printf("random: %d poses, max rotation error %.5f deg, max position error %.4f mm\n",
+           packets * 3, worst.rotationDeg, worst.positionM * 1e3);
+    FNVR_CHECK(worst.rotationDeg <= kMaxRotationErrorDeg);
+    FNVR_CHECK(worst.positionM <= kMaxPositionErrorM);
+}
+
+// Component ties, negative largest components and the identity, where the choice of
+// the dropped component and its sign matter
+void TestEdgeRotations()
+{
+    const double h = 0.5, r = 0.70710678118654752;
+    const double cases[][4] = {
+        { 1, 0, 0, 0 }, { -1, 0, 0, 0 }, { 0, 0, 0, 1 }, { 0, -1, 0, 0 },
+        { h, h, h, h }, { -h, h, -h, h }, { r, r, 0, 0 }, { 0, r, -r, 0 },
+        { 0, 0, -r, -r }, { r, 0, 0, -r },
+    };
+    const int count = sizeof(cases) / sizeof(cases[0]);
+
+    RoundTrip worst;
+    for (int c = 0; c < count; c++) {
+        double q[3][4], p[3][3] = { { 0, 0, 0 }, { -32.0, 32.0, 0.0005 }, { 1.2345, -0.0004, 0 } };
+        for (int d = 0; d < 3; d++) {
+            memcpy(q[d], cases[(c + d) % count], sizeof(q[d]));
+        }
+        CheckPoses(q, p, worst);
+    }
+    FNVR_CHECK(worst.rotationDeg <= kMaxRotationErrorDeg);
+    FNVR_CHECK(worst.positionM <= kMaxPositionErrorM);
+}
+
+void TestInputsAndMask()
+{
+    VRDataPacketFlat in;
+    memset(&in, 0, sizeof(in));
+    in.hmd_qw = in.left_qw = in.right_qw = 1.0f;
+    in.flags = VR_FLAG_MONOTONIC_TIME;
+    in.timestamp = 1234.5678;
+    in.left_trigger = 0.3f;
+    in.right_trigger = 1.0f;
+    in.left_grip = 0.0f;
+    in.right_grip = 0.77f;
+    in.left_pad_x = -1.0f;
+    in.left_pad_y = 0.25f;
+    in.right_pad_x = 0.5f;
+    in.right_pad_y = -0.6f;
+    in.right_menu = in.left_system = in.a_button = in.y_button = 1.0f;
+
+    VRDataPacketV3 wire;
+    ConvertFlatToV3(in, wire);
+    VRDataPacketFlat out;
+    ConvertV3ToFlat(wire, out);
+
+    FNVR_CHECK(out.version == 3);
+    FNVR_CHECK(out.timestamp == in.timestamp);
+    FNVR_CHECK(out.flags & VR_FLAG_MONOTONIC_TIME);
+    FNVR_CHECK(std::fabs(out.left_trigger - in.left_trigger) <= 0.5f / 255.0f);
+    FNVR_CHECK(out.right_trigger == 1.0f);
+    FNVR_CHECK(out.left_grip == 0.0f);
+    FNVR_CHECK(std::fabs(out.right_grip - in.right_grip) <= 0.5f / 255.0f);
+    FNVR_CHECK(out.left_pad_x == -1.0f);
+    FNVR_CHECK(std::fabs(out.left_pad_y - in.left_pad_y) <= 0.5f / 127.0f);
+    FNVR_CHECK(std::fabs(out.right_pad_x - in.right_pad_x) <= 0.5f / 127.0f);
+    FNVR_CHECK(std::fabs(out.right_pad_y - in.right_pad_y) <= 0.5f / 127.0f);
+    FNVR_CHECK(out.right_menu == 1.0f && out.left_system == 1.0f);
+    FNVR_CHECK(out.a_button == 1.0f && out.y_button == 1.0f);
+    FNVR_CHECK(out.right_system == 0.0f && out.left_menu == 0.0f);
+    FNVR_CHECK(out.b_button == 0.0f && out.x_button == 0.0f);
+
+    // A device missing from the mask decodes to identity at the origin
+    in.left_qw = 0.0f;
+    in.left_qy = 1.0f;
+    in.left_px = 0.4f;
+    ConvertFlatToV3(in, wire);
+    wire.deviceMask &= ~VR3_DEVICE_LEFT;
+    ConvertV3ToFlat(wire, out);
+    FNVR_CHECK(out.left_qw == 1.0f && out.left_qy == 0.0f && out.left_px == 0.0f);
+}
+
+} // namespace
+
+int main()
+{
+    TestRandomPoses();
+    TestEdgeRotations();
+    TestInputsAndMask();
+    return FNVRTest::Finish("VRDataPacketV3Test");
+}
@@ -0,0 +1,132 @@
+// fnvr_plugin/tests/VRPacketViewBench.cpp
+#include "VRPacketView.h"
+#include "PoseMailbox.h"
+#include "TestUtil.h"
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+// Bytes copied and time per sample between the transport read and the consumer
+// reading the poses:
+//   before: ConvertV2ToFlat into a VRDataPacketFlat, copied into g_currentVRData
+//           under g_dataLock, then into ApplyVRDataToSkeleton's stack copy
+//   after:  the read lands in the mailbox slot and VRPacketView reads it in place
+//           (V3 dequantizes its three poses into the view)
+// The transport read itself is the same size on both paths: timed, but not counted.
+// Timings include the hand-off between threads (mutex before, mailbox after).
+
+namespace {
+
+size_t g_bytesCopied = 0;
+
+template <typename T>
+void CountedCopy(T& to, const T& from)
+{
+    to = from;
+    g_bytesCopied += sizeof(T);
+}
+
+// What the apply stage reads from every sample
+float Consume(const VRPose& hmd, const VRPose& right, double timestamp)
+{
+    return hmd.qw + hmd.px + right.qx + right.pz + (float)timestamp;
+}
+
+struct Before {
+    std::mutex dataLock;
+    VRDataPacketFlat current;
+
+    float Sample(const VRDataPacketV2& wire)
+    {
+        VRDataPacketV2 received;
+        memcpy(&received, &wire, sizeof(received));  // The transport read
+        VRDataPacketFlat flat;
+        ConvertV2ToFlat(received, flat);
+        g_bytesCopied += sizeof(flat);
+        {
+            std::lock_guard<std::mutex> guard(dataLock);
+            CountedCopy(current, flat);
+        }
+        VRDataPacketFlat local;
+        {
+            std::lock_guard<std::mutex> guard(dataLock);
+            CountedCopy(local, current);
+        }
+        const VRPose hmd = { local.hmd_qw, local.hmd_qx, local.hmd_qy, local.hmd_qz, local.hmd_px, local.hmd_py, local.hmd_pz };
+        const VRPose right = { local.right_qw, local.right_qx, local.right_qy, local.right_qz, local.right_px, local.right_py, local.right_pz };
+        return Consume(hmd, right, local.timestamp);
+    }
+};
+
+struct After {
+    FNVR::PoseMailbox<WirePacket> mailbox;
+
+    float Sample(const void* received, uint32_t size)
+    {
+        WirePacket& slot = mailbox.BeginWrite();
+        memcpy(slot.data, received, size);  // The transport read
+        slot.size = size;
+        mailbox.Publish();
+        mailbox.Acquire();
+        VRPacketView view(mailbox.Front());
+        if (view.GetVersion() == 3) {
+            g_bytesCopied += 3 * sizeof(VRPose);
+        }
+        return Consume(view.Hmd(), view.Right(), view.GetTimestamp());
+    }
+};
+
+} // namespace
+
+int main()
+{
+    // The plugin is multithreaded; glibc skips the atomics in uncontended mutexes
+    // until a second thread has existed
+    std::thread([] {}).join();
+
+    const int iterations = 5000000;
+
+    VRDataPacketV2 v2;
+    memset(&v2, 0, sizeof(v2));
+    v2.version = 2;
+    v2.flags = VR_FLAG_BASIC_DATA;
+    v2.hmd_qw = v2.ctl_qw = 1.0f;
+    v2.ctl_px = 0.3f;
+
+    VRDataPacketFlat flat;
+    ConvertV2ToFlat(v2, flat);
+    VRDataPacketV3 v3;
+    ConvertFlatToV3(flat, v3);
+
+    float sink = 0.0f;
+    Before before;
+    After after;
+
+    g_bytesCopied = 0;
+    double beforeNs = FNVRTest::NsPerCall(iterations, [&](int i) {
+        v2.timestamp = i;
+        sink += before.Sample(v2);
+    });
+    double beforeBytes = (double)g_bytesCopied / (5.0 * iterations);
+
+    g_bytesCopied = 0;
+    double afterV2Ns = FNVRTest::NsPerCall(iterations, [&](int i) {
+        v2.timestamp = i;
+        sink += after.Sample(&v2, sizeof(v2));
+    });
+    double afterV2Bytes = (double)g_bytesCopied / (5.0 * iterations);
+
+    g_bytesCopied = 0;
+    double afterV3Ns = FNVRTest::NsPerCall(iterations, [&](int i) {
+        v3.timestamp = i;
+        sink += after.Sample(&v3, sizeof(v3));
+    });
+    double afterV3Bytes = (double)g_bytesCopied / (5.0 * iterations);
+    FNVRTest::KeepAlive(sink);
+
+    printf("per sample, transport read to poses read (read not counted)\n");
+    printf("  before, V2 -> flat copies     %5.0f bytes copied  %6.1f ns\n", beforeBytes, beforeNs);
+    printf("  after,  V2 view in place      %5.0f bytes copied  %6.1f ns\n", afterV2Bytes, afterV2Ns);
+    printf("  after,  V3 view (dequantize)  %5.0f bytes copied  %6.1f ns\n", afterV3Bytes, afterV3Ns);
+    return 0;
+}
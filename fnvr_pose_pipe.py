@@ -9,11 +9,26 @@ FNVR Pose Pipe - Modern Raw Pose Tracker
 import openvr
 import time
 import ctypes
+import mmap
+import os
+import socket
 import struct
+import sys
 import numpy as np
 
 PIPE_NAME = r"\\.\pipe\FNVRTracker"
 
+# Shared-memory ring (plugin side: SharedPoseRing.h, enable with [Transport] Mode=1)
+SHM_NAME = "FNVRTracker"
+SHM_MAGIC = 0x52564E46
+SHM_VERSION = 3
+SHM_SLOTS = 16
+SHM_HEADER_SIZE = 64
+SHM_SLOT_SIZE = 96
+
+# Loopback UDP (plugin side: UdpTrackingSource.h, enable with [Transport] Mode=2)
+UDP_ADDRESS = ("127.0.0.1", 49152)
+
 # Utility: get quaternion from 3x4 OpenVR matrix
 def get_quaternion(matrix):
     m = matrix
@@ -46,10 +61,131 @@ def rotate_vector_by_quaternion(v, q):
     qres = quaternion_multiply(q, quaternion_multiply(qvec, qinv))
     return (qres[1], qres[2], qres[3])
 
-class RawPosePipe:
+# V3 compact packet (plugin side: FNVRGlobals/VRDataPacketV3.h), enable with --v3
+V3_QUAT_SCALE = 32767.0 * 1.41421356
+V3_DEVICE_HMD, V3_DEVICE_LEFT, V3_DEVICE_RIGHT = 1, 2, 4
+V3_FLAG_MONOTONIC_TIME = 0x80
+V3_BUTTON_RIGHT_MENU, V3_BUTTON_RIGHT_SYSTEM, V3_BUTTON_LEFT_MENU, V3_BUTTON_LEFT_SYSTEM = 0x01, 0x02, 0x04, 0x08
+V3_BUTTON_A, V3_BUTTON_B, V3_BUTTON_X, V3_BUTTON_Y = 0x10, 0x20, 0x40, 0x80
+
+# Legacy OpenVR button ids (EVRButtonId). Touch-style controllers report A/X as
+# k_EButton_A and B/Y as the application menu button.
+BUTTON_SYSTEM, BUTTON_APPLICATION_MENU, BUTTON_GRIP, BUTTON_A = 0, 1, 2, 7
+
+# Packet flags (V2 flags field)
+VR_FLAG_BASIC_DATA = 0x01
+VR_FLAG_MONOTONIC_TIME = 0x02  # timestamp is time.perf_counter(); enable with --monotonic
+
+def _clamp16(v):
+    return max(-32767, min(32767, int(round(v))))
+
+def encode_quat_smallest_three(q):
+    """Returns (index of dropped largest component, three int16 components)."""
+    largest = max(range(4), key=lambda i: abs(q[i]))
+    norm = float(np.sqrt(sum(c * c for c in q))) or 1.0
+    sign = -1.0 if q[largest] < 0 else 1.0
+    comps = [_clamp16(q[i] * sign / norm * V3_QUAT_SCALE) for i in range(4) if i != largest]
+    return largest, comps
+
+def pack_v3_buttons(right_pressed, left_pressed):
+    """V3 button bits from the two controllers' ulButtonPressed masks."""
+    buttons = 0
+    for pressed, bits in ((right_pressed, ((BUTTON_APPLICATION_MENU, V3_BUTTON_RIGHT_MENU | V3_BUTTON_B),
+                                           (BUTTON_SYSTEM, V3_BUTTON_RIGHT_SYSTEM), (BUTTON_A, V3_BUTTON_A))),
+                          (left_pressed, ((BUTTON_APPLICATION_MENU, V3_BUTTON_LEFT_MENU | V3_BUTTON_Y),
+                                          (BUTTON_SYSTEM, V3_BUTTON_LEFT_SYSTEM), (BUTTON_A, V3_BUTTON_X)))):
+        for button, bit in bits:
+            if pressed & (1 << button):
+                buttons |= bit
+    return buttons
+
+def pack_v3(timestamp, hmd, left=None, right=None, buttons=0, trigger=(0.0, 0.0), grip=(0.0, 0.0), pad=((0.0, 0.0), (0.0, 0.0)), monotonic=False):
+    """hmd/left/right: (quaternion wxyz, position xyz) or None. Inputs are (left, right) pairs."""
+    device_mask, quat_largest, poses = V3_FLAG_MONOTONIC_TIME if monotonic else 0, 0, []
+    for device, (bit, pose) in enumerate(((V3_DEVICE_HMD, hmd), (V3_DEVICE_LEFT, left), (V3_DEVICE_RIGHT, right))):
+        if pose is None:
+            pose = ((1.0, 0.0, 0.0, 0.0), (0.0, 0.0, 0.0))
+        else:
+            device_mask |= bit
+        largest, comps = encode_quat_smallest_three(pose[0])
+        quat_largest |= largest << (device * 2)
+        poses += comps + [_clamp16(p * 1000.0) for p in pose[1]]
+    unit = lambda v: max(0, min(255, int(round(v * 255.0))))
+    axis = lambda v: max(-127, min(127, int(round(v * 127.0))))
+    return struct.pack(
+        '<HBBd' + '3h3h' * 3 + 'H4B4b',
+        3, device_mask, quat_largest, timestamp, *poses, buttons,
+        unit(trigger[0]), unit(trigger[1]), unit(grip[0]), unit(grip[1]),
+        axis(pad[0][0]), axis(pad[1][0]), axis(pad[0][1]), axis(pad[1][1])
+    )
+
+
+class SharedPoseRingWriter:
+    """Writes packets into the plugin's shared-memory ring using the per-slot seqlock protocol."""
+
     def __init__(self):
+        self.shm = mmap.mmap(-1, SHM_HEADER_SIZE + SHM_SLOTS * SHM_SLOT_SIZE, tagname=SHM_NAME)
+        self.sequence = 0
+        # Auto-reset event the plugin sleeps on between packets (SharedMemoryClient.cpp)
+        self.kernel32 = ctypes.windll.kernel32
+        self.kernel32.CreateEventW.restype = ctypes.c_void_p
+        self.kernel32.SetEvent.argtypes = [ctypes.c_void_p]
+        self.kernel32.CloseHandle.argtypes = [ctypes.c_void_p]
+        self.new_data_event = self.kernel32.CreateEventW(None, False, False, SHM_NAME + "_NewData")
+        # magic last so the plugin never sees a half-initialized header; writerPid lets
+        # the plugin tell a quiet tracker from one that is gone
+        struct.pack_into('<IIIIII', self.shm, 0, 0, SHM_VERSION, SHM_SLOTS, SHM_SLOT_SIZE, 0, os.getpid())
+        struct.pack_into('<I', self.shm, 0, SHM_MAGIC)
+
+    def write(self, packet):
+        self.sequence = (self.sequence + 1) & 0xFFFFFFFF or 1
+        slot = SHM_HEADER_SIZE + (self.sequence % SHM_SLOTS) * SHM_SLOT_SIZE
+        struct.pack_into('<II', self.shm, slot, 0, len(packet))
+        self.shm[slot + 8:slot + 8 + len(packet)] = packet
+        struct.pack_into('<I', self.shm, slot, self.sequence)
+        struct.pack_into('<I', self.shm, 16, self.sequence)
+        # Signal unconditionally: without a fence the readerWaiting flag can't be trusted here
+        if self.new_data_event:
+            self.kernel32.SetEvent(self.new_data_event)
+        return True
+
+    def close(self):
+        # writerPid 0 tells a waiting plugin the ring is closed
+        struct.pack_into('<I', self.shm, 20, 0)
+        if self.new_data_event:
+            self.kernel32.SetEvent(self.new_data_event)
+            self.kernel32.CloseHandle(self.new_data_event)
+        self.shm.close()
+
+
+class UdpPoseSender:
+    """Sends one packet per datagram; the plugin keeps only the newest queued one."""
+
+    def __init__(self):
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+
+    def write(self, packet):
+        try:
+            self.sock.sendto(packet, UDP_ADDRESS)
+        except OSError:
+            pass  # Nobody listening yet is not an error for UDP
+        return True
+
+    def close(self):
+        self.sock.close()
+
+
+class RawPosePipe:
+    def __init__(self, use_shm=False, use_v3=False, use_udp=False, use_monotonic=False):
+        self.use_v3 = use_v3
+        # perf_counter() is the clock the plugin measures latency with; time.time()
+        # can tick in 1-16 ms steps on older Pythons
+        self.use_monotonic = use_monotonic
+        self.clock = time.perf_counter if use_monotonic else time.time
         self.vr_system = None
         self.pipe_handle = None
+        # Non-pipe transports; None means the named pipe is used
+        self.packet_writer = UdpPoseSender() if use_udp else SharedPoseRingWriter() if use_shm else None
         self.kernel32 = ctypes.windll.kernel32
         try:
             self.vr_system = openvr.init(openvr.VRApplication_Background)
@@ -59,6 +195,8 @@ class RawPosePipe:
             exit(1)
 
     def create_pipe_and_wait(self):
+        if self.packet_writer:
+            return True
         self.pipe_handle = self.kernel32.CreateNamedPipeW(
             PIPE_NAME, 0x00000002, 0, 255, 512, 512, 0, None
         )
@@ -76,27 +214,48 @@ class RawPosePipe:
         print("Game connected!")
         return True
 
-    def send_pose(self, hmd_q, hmd_p, ctl_q, ctl_p, rel_p, timestamp):
-        # New unified packet format with flags
-        # Base packet: version (I), flags (I), hmd_q (4f), hmd_p (3f), ctl_q (4f), ctl_p (3f), rel_p (3f), timestamp (d)
-        # Total: 88 bytes (4+4+16+12+16+12+12+8)
-        
-        # For now, only send basic data (no left controller, no inputs)
-        flags = 0x01  # VR_FLAG_BASIC_DATA
+    def read_controller_inputs(self, device_index):
+        """(ulButtonPressed, trigger, grip, (pad x, pad y)) of one controller, all zero if unavailable."""
+        if device_index is None:
+            return 0, 0.0, 0.0, (0.0, 0.0)
+        result, state = self.vr_system.getControllerState(device_index)
+        if not result:
+            return 0, 0.0, 0.0, (0.0, 0.0)
+        pressed = state.ulButtonPressed
+        # Axis 1 is the trigger; axis 2 is the analog grip where the controller has one
+        grip = state.rAxis[2].x or (1.0 if pressed & (1 << BUTTON_GRIP) else 0.0)
+        return pressed, state.rAxis[1].x, grip, (state.rAxis[0].x, state.rAxis[0].y)
+
+    def send_pose(self, hmd_q, hmd_p, ctl_q, ctl_p, rel_p, timestamp, left=None, inputs=None):
+        # V2 packet: version (I), flags (I), hmd_q (4f), hmd_p (3f), ctl_q (4f), ctl_p (3f), rel_p (3f), timestamp (d)
+        # Total: 84 bytes (4+4+16+12+16+12+12+8). HMD and right controller only.
+        # V3 also carries left (quaternion, position; None = not tracked) and inputs
+        # (right, left) tuples from read_controller_inputs.
+        flags = VR_FLAG_BASIC_DATA | (VR_FLAG_MONOTONIC_TIME if self.use_monotonic else 0)
         
-        packet = struct.pack(
-            '<II4f3f4f3f3fd',
-            2,                # version
-            flags,            # flags (basic data only)
-            *hmd_q, *hmd_p,   # HMD quaternion, position
-            *ctl_q, *ctl_p,   # Right controller quaternion, position
-            *rel_p,           # Controller pos relative to HMD (meters)
-            timestamp         # Timestamp (seconds since epoch)
-        )
+        if self.use_v3:
+            # 58-byte V3 packet; rel_p is derived by the plugin and not sent
+            right_in, left_in = inputs or ((0, 0.0, 0.0, (0.0, 0.0)), (0, 0.0, 0.0, (0.0, 0.0)))
+            packet = pack_v3(timestamp, (hmd_q, hmd_p), left=left, right=(ctl_q, ctl_p),
+                             buttons=pack_v3_buttons(right_in[0], left_in[0]),
+                             trigger=(left_in[1], right_in[1]), grip=(left_in[2], right_in[2]),
+                             pad=(left_in[3], right_in[3]), monotonic=self.use_monotonic)
+        else:
+            packet = struct.pack(
+                '<II4f3f4f3f3fd',
+                2,                # version
+                flags,            # flags (basic data only)
+                *hmd_q, *hmd_p,   # HMD quaternion, position
+                *ctl_q, *ctl_p,   # Right controller quaternion, position
+                *rel_p,           # Controller pos relative to HMD (meters)
+                timestamp         # Timestamp (seconds since epoch, or perf_counter with --monotonic)
+            )
         # Debug: Print packet size on first send
         if not hasattr(self, '_first_packet_logged'):
             print(f"Sending packet size: {len(packet)} bytes")
             self._first_packet_logged = True
+        if self.packet_writer:
+            return self.packet_writer.write(packet)
         bytes_written = ctypes.c_ulong()
         success = self.kernel32.WriteFile(
             self.pipe_handle, packet, len(packet),
@@ -110,6 +269,9 @@ class RawPosePipe:
         return True
 
     def shutdown(self):
+        if self.packet_writer:
+            self.packet_writer.close()
+            self.packet_writer = None
         if self.pipe_handle:
             self.kernel32.CloseHandle(self.pipe_handle)
             self.pipe_handle = None
@@ -125,17 +287,19 @@ class RawPosePipe:
         max_devices = openvr.k_unMaxTrackedDeviceCount
         TrackedDevicePose_t = openvr.TrackedDevicePose_t
         right_controller_index = None
+        left_controller_index = None
         for device_index in range(max_devices):
             if self.vr_system.isTrackedDeviceConnected(device_index):
                 device_class = self.vr_system.getTrackedDeviceClass(device_index)
                 if device_class == openvr.TrackedDeviceClass_Controller:
                     role = self.vr_system.getControllerRoleForTrackedDeviceIndex(device_index)
-                    if role == openvr.TrackedControllerRole_RightHand:
+                    if role == openvr.TrackedControllerRole_RightHand and right_controller_index is None:
                         right_controller_index = device_index
-                        break
+                    elif role == openvr.TrackedControllerRole_LeftHand and left_controller_index is None:
+                        left_controller_index = device_index
         if right_controller_index is None:
             for device_index in range(max_devices):
-                if self.vr_system.isTrackedDeviceConnected(device_index):
+                if self.vr_system.isTrackedDeviceConnected(device_index) and device_index != left_controller_index:
                     device_class = self.vr_system.getTrackedDeviceClass(device_index)
                     if device_class == openvr.TrackedDeviceClass_Controller:
                         right_controller_index = device_index
@@ -146,11 +310,13 @@ class RawPosePipe:
         dummy_rel_p = (0.0, 0.0, 0.0)       # No relative position
         
         print(f"Controller index: {right_controller_index}")
+        if self.use_v3:
+            print(f"Left controller index: {left_controller_index}")
         if right_controller_index is None:
             print("WARNING: No controller found! Using dummy data.")
         
         while True:
-            if not self.pipe_handle:
+            if not self.pipe_handle and not self.packet_writer:
                 if not self.create_pipe_and_wait():
                     break
             poses_array = (TrackedDevicePose_t * max_devices)()
@@ -188,13 +354,27 @@ class RawPosePipe:
                         ctl_p = dummy_ctl_p
                         rel_p = dummy_rel_p
                     
-                    timestamp = time.time()
-                    self.send_pose(hmd_q, hmd_p, ctl_q, ctl_p, rel_p, timestamp)
+                    # V3 only: left controller pose (omitted from the packet while not
+                    # tracking) and both controllers' buttons and axes
+                    left = None
+                    inputs = None
+                    if self.use_v3:
+                        if left_controller_index is not None and len(returned_poses) > left_controller_index:
+                            left_pose = returned_poses[left_controller_index]
+                            if left_pose.bPoseIsValid:
+                                l = left_pose.mDeviceToAbsoluteTracking
+                                left = (get_quaternion(l), get_position(l))
+                        inputs = (self.read_controller_inputs(right_controller_index),
+                                  self.read_controller_inputs(left_controller_index))
+
+                    timestamp = self.clock()
+                    self.send_pose(hmd_q, hmd_p, ctl_q, ctl_p, rel_p, timestamp, left=left, inputs=inputs)
                     
             time.sleep(1.0/120.0)  # 120 Hz update
 
 if __name__ == "__main__":
-    app = RawPosePipe()
+    app = RawPosePipe(use_shm="--shm" in sys.argv, use_v3="--v3" in sys.argv, use_udp="--udp" in sys.argv,
+                      use_monotonic="--monotonic" in sys.argv)
     try:
         app.run()
     finally: